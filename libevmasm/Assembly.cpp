@@ -32,9 +32,14 @@
 
 #include <liblangutil/Exceptions.h>
 
-#include <fstream>
 #include <json/json.h>
 
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <thread>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -396,24 +401,121 @@ Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 	return *this;
 }
 
+vector<map<u256, u256>> Assembly::optimiseSubs(OptimiserSettings const& _settings)
+{
+	OptimiserSettings settings = _settings;
+	// Disable creation mode for sub-assemblies.
+	settings.isCreation = false;
+
+	// The replacements of a sub-assembly only affect the tags of that sub-assembly in our
+	// items, so the referenced tags do not depend on the order in which the subs are optimised.
+	vector<set<size_t>> referencedTags;
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		referencedTags.emplace_back(JumpdestRemover::referencedTags(m_items, subId));
+
+	vector<map<u256, u256>> tagReplacements(m_subs.size());
+	size_t threadCount = min(_settings.threadCount, m_subs.size());
+	if (threadCount <= 1)
+	{
+		for (size_t subId = 0; subId < m_subs.size(); ++subId)
+			tagReplacements[subId] = m_subs[subId]->optimiseInternal(settings, move(referencedTags[subId]));
+		return tagReplacements;
+	}
+	settings.threadCount = max<size_t>(1, _settings.threadCount / threadCount);
+
+	// Different subs can contain the same assembly, for example the creation and the runtime
+	// assembly of a contract. Such a sub is only optimised after all earlier subs that share
+	// an assembly with it, which is the order of the sequential optimisation.
+	vector<set<Assembly const*>> contained(m_subs.size());
+	vector<vector<size_t>> conflicts(m_subs.size());
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+	{
+		vector<Assembly const*> toVisit{m_subs[subId].get()};
+		while (!toVisit.empty())
+		{
+			Assembly const* assembly = toVisit.back();
+			toVisit.pop_back();
+			if (contained[subId].insert(assembly).second)
+				for (auto const& sub: assembly->m_subs)
+					toVisit.push_back(sub.get());
+		}
+		for (size_t earlierSubId = 0; earlierSubId < subId; ++earlierSubId)
+			if (any_of(
+				contained[subId].begin(),
+				contained[subId].end(),
+				[&](Assembly const* _assembly) { return contained[earlierSubId].count(_assembly) > 0; }
+			))
+				conflicts[subId].push_back(earlierSubId);
+	}
+
+	enum class State { Pending, Running, Done };
+	vector<State> states(m_subs.size(), State::Pending);
+	vector<exception_ptr> errors(m_subs.size());
+	mutex stateMutex;
+	condition_variable subFinished;
+	auto isDone = [&](size_t _subId) { return states[_subId] == State::Done; };
+	auto worker = [&]()
+	{
+		unique_lock<mutex> lock(stateMutex);
+		while (true)
+		{
+			optional<size_t> subId;
+			bool pending = false;
+			for (size_t i = 0; i < m_subs.size() && !subId; ++i)
+				if (states[i] == State::Pending)
+				{
+					pending = true;
+					if (all_of(conflicts[i].begin(), conflicts[i].end(), isDone))
+						subId = i;
+				}
+			if (!subId)
+			{
+				if (!pending)
+					break;
+				subFinished.wait(lock);
+				continue;
+			}
+
+			states[*subId] = State::Running;
+			lock.unlock();
+			try
+			{
+				tagReplacements[*subId] = m_subs[*subId]->optimiseInternal(settings, move(referencedTags[*subId]));
+			}
+			catch (...)
+			{
+				errors[*subId] = current_exception();
+			}
+			lock.lock();
+			states[*subId] = State::Done;
+			subFinished.notify_all();
+		}
+	};
+
+	vector<thread> threads;
+	for (size_t i = 1; i < threadCount; ++i)
+		threads.emplace_back(worker);
+	worker();
+	for (thread& workerThread: threads)
+		workerThread.join();
+
+	// Report the error the sequential optimisation would have reported.
+	for (exception_ptr const& error: errors)
+		if (error)
+			rethrow_exception(error);
+	return tagReplacements;
+}
+
 map<u256, u256> Assembly::optimiseInternal(
 	OptimiserSettings const& _settings,
 	std::set<size_t> _tagsReferencedFromOutside
 )
 {
 	// Run optimisation for sub-assemblies.
+	vector<map<u256, u256>> subTagReplacements = optimiseSubs(_settings);
 	for (size_t subId = 0; subId < m_subs.size(); ++subId)
-	{
-		OptimiserSettings settings = _settings;
-		// Disable creation mode for sub-assemblies.
-		settings.isCreation = false;
-		map<u256, u256> subTagReplacements = m_subs[subId]->optimiseInternal(
-			settings,
-			JumpdestRemover::referencedTags(m_items, subId)
-		);
 		// Apply the replacements (can be empty).
-		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements, subId);
-	}
+		BlockDeduplicator::applyTagReplacement(m_items, subTagReplacements[subId], subId);
 
 	map<u256, u256> tagReplacements;
 	// Iterate until no new optimisation possibilities are found.
@@ -431,11 +533,8 @@ map<u256, u256> Assembly::optimiseInternal(
 		if (_settings.runPeephole)
 		{
 			PeepholeOptimiser peepOpt{m_items};
-			while (peepOpt.optimise())
-			{
+			if (peepOpt.optimise())
 				count++;
-				assertThrow(count < 64000, OptimizerException, "Peephole optimizer seems to be stuck.");
-			}
 		}
 
 		// This only modifies PushTags, we have to run again to actually remove code.
@@ -575,7 +674,8 @@ LinkerObject const& Assembly::assemble() const
 
 	unsigned bytesRequiredForCode = bytesRequired(static_cast<unsigned>(subTagSize));
 	m_tagPositionsInBytecode = vector<size_t>(m_usedTags, numeric_limits<size_t>::max());
-	map<size_t, pair<size_t, size_t>> tagRef;
+	// Positions of pushed tags in increasing order, together with the sub and tag id.
+	vector<pair<size_t, pair<size_t, size_t>>> tagRef;
 	multimap<h256, unsigned> dataRef;
 	multimap<size_t, size_t> subRef;
 	vector<unsigned> sizeRef; ///< Pointers to code locations where the size of the program is inserted
@@ -588,7 +688,12 @@ LinkerObject const& Assembly::assemble() const
 
 	unsigned bytesPerDataRef = util::bytesRequired(bytesRequiredIncludingData);
 	uint8_t dataRefPush = static_cast<uint8_t>(pushInstruction(bytesPerDataRef));
-	ret.bytecode.reserve(bytesRequiredIncludingData);
+	// Reserve enough space for the code and everything appended to it, so that it never has to
+	// be reallocated.
+	size_t bytesToReserve = bytesRequiredIncludingData;
+	for (auto const& dataItem: m_data)
+		bytesToReserve += dataItem.second.size();
+	ret.bytecode.reserve(bytesToReserve);
 
 	for (AssemblyItem const& i: m_items)
 	{
@@ -626,7 +731,7 @@ LinkerObject const& Assembly::assemble() const
 		case PushTag:
 		{
 			ret.bytecode.push_back(tagPush);
-			tagRef[ret.bytecode.size()] = i.splitForeignPushTag();
+			tagRef.emplace_back(ret.bytecode.size(), i.splitForeignPushTag());
 			ret.bytecode.resize(ret.bytecode.size() + bytesPerTag);
 			break;
 		}
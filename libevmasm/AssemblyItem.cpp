@@ -324,12 +324,17 @@ std::string AssemblyItem::computeSourceMapping(
 )
 {
 	string ret;
+	// Most entries are empty or short, since they only contain what changed.
+	ret.reserve(_items.size() * 4);
 
 	int prevStart = -1;
 	int prevLength = -1;
 	int prevSourceIndex = -1;
 	int prevModifierDepth = -1;
 	char prevJump = 0;
+	// Consecutive items mostly come from the same source, so only look up its index if it changes.
+	CharStream const* source = nullptr;
+	int sourceIndex = -1;
 	for (auto const& item: _items)
 	{
 		if (!ret.empty())
@@ -337,10 +342,12 @@ std::string AssemblyItem::computeSourceMapping(
 
 		SourceLocation const& location = item.location();
 		int length = location.start != -1 && location.end != -1 ? location.end - location.start : -1;
-		int sourceIndex =
-			location.source && _sourceIndicesMap.count(location.source->name()) ?
-			static_cast<int>(_sourceIndicesMap.at(location.source->name())) :
-			-1;
+		if (location.source.get() != source)
+		{
+			source = location.source.get();
+			auto it = source ? _sourceIndicesMap.find(source->name()) : _sourceIndicesMap.end();
+			sourceIndex = it != _sourceIndicesMap.end() ? static_cast<int>(it->second) : -1;
+		}
 		char jump = '-';
 		if (item.getJumpType() == evmasm::AssemblyItem::JumpType::IntoFunction)
 			jump = 'i';
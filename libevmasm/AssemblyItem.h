@@ -28,6 +28,8 @@
 #include <libsolutil/Common.h>
 #include <libsolutil/Assertions.h>
 #include <iostream>
+#include <memory>
+#include <optional>
 #include <sstream>
 
 namespace solidity::evmasm
@@ -73,7 +75,7 @@ public:
 		if (m_type == Operation)
 			m_instruction = Instruction(uint8_t(_data));
 		else
-			m_data = std::make_shared<u256>(std::move(_data));
+			m_data = CompactValue(_data);
 	}
 	AssemblyItem(AssemblyItem const&) = default;
 	AssemblyItem(AssemblyItem&&) = default;
@@ -92,8 +94,8 @@ public:
 	void setPushTagSubIdAndTag(size_t _subId, size_t _tag);
 
 	AssemblyItemType type() const { return m_type; }
-	u256 const& data() const { assertThrow(m_type != Operation, util::Exception, ""); return *m_data; }
-	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); m_data = std::make_shared<u256>(_data); }
+	u256 data() const { assertThrow(m_type != Operation, util::Exception, ""); return m_data.value(); }
+	void setData(u256 const& _data) { assertThrow(m_type != Operation, util::Exception, ""); m_data = CompactValue(_data); }
 
 	/// @returns the instruction of this item (only valid if type() == Operation)
 	Instruction instruction() const { assertThrow(m_type == Operation, util::Exception, ""); return m_instruction; }
@@ -106,7 +108,7 @@ public:
 		if (type() == Operation)
 			return instruction() == _other.instruction();
 		else
-			return data() == _other.data();
+			return m_data == _other.m_data;
 	}
 	bool operator!=(AssemblyItem const& _other) const { return !operator==(_other); }
 	/// Less-than operator compatible with operator==.
@@ -117,7 +119,7 @@ public:
 		else if (type() == Operation)
 			return instruction() < _other.instruction();
 		else
-			return data() < _other.data();
+			return m_data < _other.m_data;
 	}
 
 	/// Shortcut that avoids constructing an AssemblyItem just to perform the comparison.
@@ -149,26 +151,70 @@ public:
 	JumpType getJumpType() const { return m_jumpType; }
 	std::string getJumpTypeAsString() const;
 
-	void setPushedValue(u256 const& _value) const { m_pushedValue = std::make_shared<u256>(_value); }
-	u256 const* pushedValue() const { return m_pushedValue.get(); }
+	void setPushedValue(u256 const& _value) const { m_pushedValue = CompactValue(_value); }
+	std::optional<u256> pushedValue() const
+	{
+		if (m_pushedValue)
+			return m_pushedValue->value();
+		return std::nullopt;
+	}
 
 	std::string toAssemblyText(Assembly const& _assembly) const;
 
 	size_t m_modifierDepth = 0;
 
-	void setImmutableOccurrences(size_t _n) const { m_immutableOccurrences = std::make_shared<size_t>(_n); }
+	void setImmutableOccurrences(size_t _n) const { m_immutableOccurrences = _n; }
 
 private:
+	/// Representation of a 256-bit value that does not need a heap allocation per item:
+	/// Values that fit into 64 bits are stored inline, larger values in an immutable
+	/// allocation that is shared by the copies of the item and freed with the last of them.
+	class CompactValue
+	{
+	public:
+		CompactValue() = default;
+		explicit CompactValue(u256 const& _value)
+		{
+			if (_value <= std::numeric_limits<uint64_t>::max())
+				m_inline = static_cast<uint64_t>(_value);
+			else
+				m_large = std::make_shared<u256 const>(_value);
+		}
+
+		u256 value() const { return m_large ? *m_large : u256(m_inline); }
+
+		bool operator==(CompactValue const& _other) const
+		{
+			if (m_large && _other.m_large)
+				return m_large == _other.m_large || *m_large == *_other.m_large;
+			return !m_large && !_other.m_large && m_inline == _other.m_inline;
+		}
+		/// Less-than operator compatible with the order of the values.
+		bool operator<(CompactValue const& _other) const
+		{
+			if (!m_large && !_other.m_large)
+				return m_inline < _other.m_inline;
+			else if (!m_large || !_other.m_large)
+				return !m_large;
+			else
+				return *m_large < *_other.m_large;
+		}
+
+	private:
+		std::shared_ptr<u256 const> m_large;
+		uint64_t m_inline = 0;
+	};
+
 	AssemblyItemType m_type;
 	Instruction m_instruction; ///< Only valid if m_type == Operation
-	std::shared_ptr<u256> m_data; ///< Only valid if m_type != Operation
-	langutil::SourceLocation m_location;
 	JumpType m_jumpType = JumpType::Ordinary;
+	CompactValue m_data; ///< Only valid if m_type != Operation
+	langutil::SourceLocation m_location;
 	/// Pushed value for operations with data to be determined during assembly stage,
 	/// e.g. PushSubSize, PushTag, PushSub, etc.
-	mutable std::shared_ptr<u256> m_pushedValue;
+	mutable std::optional<CompactValue> m_pushedValue;
 	/// Number of PushImmutable's with the same hash. Only used for AssignImmutable.
-	mutable std::shared_ptr<size_t> m_immutableOccurrences;
+	mutable std::optional<size_t> m_immutableOccurrences;
 };
 
 inline size_t bytesRequired(AssemblyItems const& _items, size_t _addressLength)
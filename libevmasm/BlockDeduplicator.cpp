@@ -27,18 +27,49 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <libsolutil/Word256.h>
+
+#include <algorithm>
 #include <functional>
+#include <limits>
+#include <numeric>
 #include <set>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
 
+namespace
+{
+
+/// Base of the polynomial hash of the items of a block.
+uint64_t constexpr c_hashBase = 0x100000001b3;
+
+/// @returns a hash that is equal for items that compare equal.
+uint64_t hashItem(AssemblyItem const& _item)
+{
+	uint64_t hash = static_cast<uint64_t>(_item.type()) + 1;
+	if (_item.type() == Operation)
+		return hash * c_hashBase + static_cast<uint64_t>(_item.instruction());
+	util::Word256 data(_item.data());
+	for (size_t i = 0; i < 4; ++i)
+		hash = (hash ^ data.limb(i)) * 0x9e3779b97f4a7c15;
+	return hash;
+}
+
+bool endsBlock(AssemblyItem const& _item)
+{
+	return SemanticInformation::altersControlFlow(_item) && _item != AssemblyItem{Instruction::JUMPI};
+}
+
+}
 
 bool BlockDeduplicator::deduplicate()
 {
-	// Compares indices based on the suffix that starts there, ignoring tags and stopping at
-	// opcodes that stop the control flow.
+	// Compares blocks based on the suffix that starts at their tag, ignoring tags and stopping at
+	// opcodes that stop the control flow. Every tag is replaced by the first tag whose block
+	// has the same content. This is repeated until no pushed tag changes anymore.
 
 	// Virtual tag that signifies "the current block" and which is used to optimise loops.
 	// We abort if this virtual tag actually exists.
@@ -49,54 +80,179 @@ bool BlockDeduplicator::deduplicate()
 	)
 		return false;
 
-	function<bool(size_t, size_t)> comparator = [&](size_t _i, size_t _j)
+	auto sameBlock = [&](size_t _i, size_t _j)
 	{
-		if (_i == _j)
-			return false;
-
 		// To compare recursive loops, we have to already unify PushTag opcodes of the
 		// block's own tag.
-		AssemblyItem pushFirstTag{pushSelf};
-		AssemblyItem pushSecondTag{pushSelf};
-
-		if (_i < m_items.size() && m_items.at(_i).type() == Tag)
-			pushFirstTag = m_items.at(_i).pushTag();
-		if (_j < m_items.size() && m_items.at(_j).type() == Tag)
-			pushSecondTag = m_items.at(_j).pushTag();
+		AssemblyItem pushFirstTag = m_items.at(_i).pushTag();
+		AssemblyItem pushSecondTag = m_items.at(_j).pushTag();
 
 		using diff_type = BlockIterator::difference_type;
 		BlockIterator first{m_items.begin() + diff_type(_i), m_items.end(), &pushFirstTag, &pushSelf};
 		BlockIterator second{m_items.begin() + diff_type(_j), m_items.end(), &pushSecondTag, &pushSelf};
 		BlockIterator end{m_items.end(), m_items.end()};
 
-		if (first != end && (*first).type() == Tag)
-			++first;
-		if (second != end && (*second).type() == Tag)
-			++second;
+		return std::equal(++first, end, ++second, end);
+	};
+
+	// Blocks are only compared if their hashes are equal. The hash of a block is a polynomial
+	// hash of its items, where the pushes of its own tag count as pushSelf. It is the hash of
+	// the suffix of items that starts with the block, corrected for the pushes of its own tag.
+	// When pushed tags are replaced, only the suffixes and blocks that contain them are updated.
+	size_t const size = m_items.size();
+	// Next item of the same block that is not a tag.
+	vector<size_t> next(size, size);
+	// Position after the last item of the block that starts with the item.
+	vector<size_t> blockEnd(size, size);
+	vector<uint64_t> suffixHash(size + 1, 0);
+	// Number of items before the item that are not tags.
+	vector<size_t> nonTagsBefore(size + 1, 0);
+	vector<uint64_t> powers(size + 1, 1);
+	for (size_t i = 0; i < size; ++i)
+	{
+		nonTagsBefore[i + 1] = nonTagsBefore[i] + (m_items[i].type() == Tag ? 0 : 1);
+		powers[i + 1] = powers[i] * c_hashBase;
+	}
+
+	vector<size_t> tags;
+	vector<size_t> tagAt(size, numeric_limits<size_t>::max());
+	for (size_t i = 0; i < size; ++i)
+		if (m_items[i].type() == Tag)
+		{
+			tagAt[i] = tags.size();
+			tags.push_back(i);
+		}
+	vector<size_t> blockStart(tags.size(), size);
+	for (size_t i = size, following = size; i-- > 0;)
+		if (m_items[i].type() == Tag)
+			blockStart[tagAt[i]] = following;
+		else
+		{
+			if (endsBlock(m_items[i]))
+				blockEnd[i] = i + 1;
+			else if (following != size)
+			{
+				next[i] = following;
+				blockEnd[i] = blockEnd[following];
+			}
+			suffixHash[i] = hashItem(m_items[i]) + c_hashBase * suffixHash[next[i]];
+			following = i;
+		}
+
+	map<u256, set<size_t>> pushes;
+	for (size_t i = 0; i < size; ++i)
+		if (m_items[i].type() == PushTag && m_items[i].splitForeignPushTag().first == numeric_limits<size_t>::max())
+			pushes[m_items[i].data()].insert(i);
 
-		return std::lexicographical_compare(first, end, second, end);
+	uint64_t const pushSelfHash = hashItem(pushSelf);
+	auto blockHash = [&](size_t _tag)
+	{
+		size_t start = blockStart[_tag];
+		uint64_t hash = suffixHash[start];
+		auto ownPushes = pushes.find(m_items[tags[_tag]].data());
+		if (start != size && ownPushes != pushes.end())
+			for (
+				auto it = ownPushes->second.lower_bound(start);
+				it != ownPushes->second.end() && *it < blockEnd[start];
+				++it
+			)
+				hash += (pushSelfHash - hashItem(m_items[*it])) * powers[nonTagsBefore[*it] - nonTagsBefore[start]];
+		return hash;
 	};
 
-	size_t iterations = 0;
-	for (; ; ++iterations)
+	// Blocks with the same content, ordered by their position.
+	vector<set<size_t>> classes;
+	vector<size_t> classOf(tags.size(), numeric_limits<size_t>::max());
+	unordered_map<uint64_t, vector<size_t>> buckets;
+	vector<size_t> outdated(tags.size());
+	iota(outdated.begin(), outdated.end(), 0);
+	vector<size_t> visitedInIteration(size, 0);
+
+	bool changed = false;
+	for (size_t iteration = 1; !outdated.empty(); ++iteration)
 	{
-		//@todo this should probably be optimized.
-		set<size_t, function<bool(size_t, size_t)>> blocksSeen(comparator);
-		for (size_t i = 0; i < m_items.size(); ++i)
+		// Tags whose replacement has to be determined again, because the first block
+		// with the same content changed.
+		set<size_t> toReplace;
+		for (size_t tag: outdated)
+			if (classOf[tag] != numeric_limits<size_t>::max())
+			{
+				set<size_t>& members = classes[classOf[tag]];
+				bool first = *members.begin() == tag;
+				members.erase(tag);
+				if (first)
+					toReplace.insert(members.begin(), members.end());
+			}
+		for (size_t tag: outdated)
 		{
-			if (m_items.at(i).type() != Tag)
-				continue;
-			auto it = blocksSeen.find(i);
-			if (it == blocksSeen.end())
-				blocksSeen.insert(i);
+			vector<size_t>& bucket = buckets[blockHash(tag)];
+			auto it = find_if(bucket.begin(), bucket.end(), [&](size_t _class) {
+				return !classes[_class].empty() && sameBlock(tags[*classes[_class].begin()], tags[tag]);
+			});
+			if (it != bucket.end())
+				classOf[tag] = *it;
+			else
+			{
+				classOf[tag] = classes.size();
+				bucket.push_back(classes.size());
+				classes.emplace_back();
+			}
+			set<size_t>& members = classes[classOf[tag]];
+			members.insert(tag);
+			if (*members.begin() == tag)
+				toReplace.insert(members.begin(), members.end());
 			else
-				m_replacedTags[m_items.at(i).data()] = m_items.at(*it).data();
+				toReplace.insert(tag);
 		}
 
-		if (!applyTagReplacement(m_items, m_replacedTags))
+		// Pushes of tags that were replaced before have already been changed, so only the
+		// pushes of the tags replaced now can change.
+		vector<size_t> changedPushes;
+		for (size_t tag: toReplace)
+		{
+			size_t first = *classes[classOf[tag]].begin();
+			if (first == tag)
+				continue;
+			u256 tagData = m_items[tags[tag]].data();
+			m_replacedTags[tagData] = m_items[tags[first]].data();
+			auto tagPushes = pushes.find(tagData);
+			if (tagPushes == pushes.end())
+				continue;
+			// Recursively look for the element replaced by the tag.
+			u256 replacement = tagData;
+			for (auto it = m_replacedTags.find(replacement); it != m_replacedTags.end(); it = m_replacedTags.find(replacement))
+				replacement = it->second;
+			set<size_t>& replacementPushes = pushes[replacement];
+			for (size_t position: tagPushes->second)
+			{
+				m_items[position].setPushTagSubIdAndTag(numeric_limits<size_t>::max(), static_cast<size_t>(replacement));
+				replacementPushes.insert(position);
+				changedPushes.push_back(position);
+			}
+			pushes.erase(tagPushes);
+		}
+		if (changedPushes.empty())
 			break;
+		changed = true;
+
+		// Update the hashes of the suffixes that contain a changed push and collect
+		// the tags of the blocks that contain it.
+		set<size_t> tagsToUpdate;
+		sort(changedPushes.begin(), changedPushes.end(), greater<size_t>());
+		for (size_t position: changedPushes)
+			for (size_t i = position + 1; i-- > 0 && visitedInIteration[i] != iteration;)
+			{
+				visitedInIteration[i] = iteration;
+				if (m_items[i].type() == Tag)
+					tagsToUpdate.insert(tagAt[i]);
+				else if (endsBlock(m_items[i]))
+					break;
+				else
+					suffixHash[i] = hashItem(m_items[i]) + c_hashBase * suffixHash[next[i]];
+			}
+		outdated.assign(tagsToUpdate.begin(), tagsToUpdate.end());
 	}
-	return iterations > 0;
+	return changed;
 }
 
 bool BlockDeduplicator::applyTagReplacement(
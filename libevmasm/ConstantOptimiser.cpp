@@ -24,6 +24,10 @@
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
 
+#include <libsolutil/LRUCache.h>
+
+#include <tuple>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
@@ -187,6 +191,26 @@ AssemblyItems const& CodeCopyMethod::copyRoutine()
 	return copyRoutine;
 }
 
+AssemblyItems ComputeMethod::cachedRepresentation()
+{
+	// The search only depends on the value and the parameters.
+	using Key = tuple<u256, bool, size_t, size_t, langutil::EVMVersion>;
+	static util::LRUCache<Key, AssemblyItems> cache(4096);
+
+	Key key{m_value, m_params.isCreation, m_params.runs, m_params.multiplicity, m_params.evmVersion};
+	if (optional<AssemblyItems> routine = cache.get(key))
+		return move(*routine);
+
+	AssemblyItems routine = findRepresentation(m_value);
+	assertThrow(
+		checkRepresentation(m_value, routine),
+		OptimizerException,
+		"Invalid constant expression created."
+	);
+	cache.set(key, routine);
+	return routine;
+}
+
 AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 {
 	if (_value < 0x10000)
@@ -134,12 +134,7 @@ public:
 	explicit ComputeMethod(Params const& _params, u256 const& _value):
 		ConstantOptimisationMethod(_params, _value)
 	{
-		m_routine = findRepresentation(m_value);
-		assertThrow(
-			checkRepresentation(m_value, m_routine),
-			OptimizerException,
-			"Invalid constant expression created."
-		);
+		m_routine = cachedRepresentation();
 	}
 
 	bigint gasNeeded() const override { return gasNeeded(m_routine); }
@@ -149,6 +144,9 @@ public:
 	}
 
 protected:
+	/// @returns the representation of @a m_value found by @a findRepresentation, looking it up in
+	/// a process-wide cache first, as the same constants tend to occur in many contracts.
+	AssemblyItems cachedRepresentation();
 	/// Tries to recursively find a way to compute @a _value.
 	AssemblyItems findRepresentation(u256 const& _value);
 	/// Recomputes the value from the calculated representation and checks for correctness.
@@ -27,6 +27,8 @@
 #include <libevmasm/CommonSubexpressionEliminator.h>
 #include <libevmasm/SimplificationRules.h>
 
+#include <boost/functional/hash.hpp>
+
 #include <functional>
 #include <tuple>
 #include <utility>
@@ -51,8 +53,36 @@ bool ExpressionClasses::Expression::operator<(ExpressionClasses::Expression cons
 			std::tie(otherInstr, _other.arguments, _other.sequenceNumber);
 	}
 	else
-		return std::tie(item->data(), arguments, sequenceNumber) <
-			std::tie(_other.item->data(), _other.arguments, _other.sequenceNumber);
+	{
+		u256 data = item->data();
+		u256 otherData = _other.item->data();
+		return std::tie(data, arguments, sequenceNumber) <
+			std::tie(otherData, _other.arguments, _other.sequenceNumber);
+	}
+}
+
+bool ExpressionClasses::Expression::operator==(ExpressionClasses::Expression const& _other) const
+{
+	assertThrow(!!item && !!_other.item, OptimizerException, "");
+	if (item->type() != _other.item->type() || arguments != _other.arguments || sequenceNumber != _other.sequenceNumber)
+		return false;
+	else if (item->type() == Operation)
+		return item->instruction() == _other.item->instruction();
+	else
+		return item->data() == _other.item->data();
+}
+
+size_t ExpressionClasses::ExpressionHash::operator()(ExpressionClasses::Expression const& _expression) const
+{
+	assertThrow(!!_expression.item, OptimizerException, "");
+	size_t hash = static_cast<size_t>(_expression.item->type());
+	if (_expression.item->type() == Operation)
+		boost::hash_combine(hash, static_cast<size_t>(_expression.item->instruction()));
+	else
+		boost::hash_combine(hash, _expression.item->data());
+	boost::hash_combine(hash, _expression.sequenceNumber);
+	boost::hash_range(hash, _expression.arguments.begin(), _expression.arguments.end());
+	return hash;
 }
 
 ExpressionClasses::Id ExpressionClasses::find(
@@ -133,7 +163,7 @@ bool ExpressionClasses::knownToBeDifferent(ExpressionClasses::Id _a, ExpressionC
 bool ExpressionClasses::knownToBeDifferentBy32(ExpressionClasses::Id _a, ExpressionClasses::Id _b)
 {
 	// Try to simplify "_a - _b" and return true iff the value is at least 32 away from zero.
-	u256 const* v = knownConstant(find(Instruction::SUB, {_a, _b}));
+	optional<u256> v = knownConstant(find(Instruction::SUB, {_a, _b}));
 	// forbidden interval is ["-31", 31]
 	return v && *v + 31 > u256(62);
 }
@@ -148,14 +178,14 @@ bool ExpressionClasses::knownNonZero(Id _c)
 	return Pattern(u256(0)).matches(representative(find(Instruction::ISZERO, {_c})), *this);
 }
 
-u256 const* ExpressionClasses::knownConstant(Id _c)
+optional<u256> ExpressionClasses::knownConstant(Id _c)
 {
 	map<unsigned, Expression const*> matchGroups;
 	Pattern constant(Push);
 	constant.setMatchGroup(1, matchGroups);
 	if (!constant.matches(representative(_c), *this))
-		return nullptr;
-	return &constant.d();
+		return nullopt;
+	return constant.d();
 }
 
 AssemblyItem const* ExpressionClasses::storeItem(AssemblyItem const& _item)
@@ -183,7 +213,8 @@ string ExpressionClasses::fullDAGToString(ExpressionClasses::Id _id) const
 
 ExpressionClasses::Id ExpressionClasses::tryToSimplify(Expression const& _expr)
 {
-	static Rules rules;
+	// The rules store the current match groups, so they cannot be shared between threads.
+	thread_local Rules rules;
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
 	if (
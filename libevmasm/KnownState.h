@@ -38,6 +38,7 @@
 #endif // defined(__clang__)
 
 #include <boost/bimap.hpp>
+#include <boost/container/flat_map.hpp>
 
 #if defined(__clang__)
 #pragma clang diagnostic pop
@@ -71,6 +72,10 @@ class KnownState
 {
 public:
 	using Id = ExpressionClasses::Id;
+	/// Flat sorted maps, so that copying a state (which happens at every branch of the control
+	/// flow) is a single allocation per map.
+	using StackElements = boost::container::flat_map<int, Id>;
+	using Content = boost::container::flat_map<Id, Id>;
 	struct StoreOperation
 	{
 		enum Target { Invalid, Memory, Storage };
@@ -113,7 +118,8 @@ public:
 	/// @param _combineSequenceNumbers if true, sets the sequence number to the maximum of both
 	void reduceToCommonKnowledge(KnownState const& _other, bool _combineSequenceNumbers);
 
-	/// @returns a shared pointer to a copy of this state.
+	/// @returns a shared pointer to a copy of this state. The Keccak-256 hashes and tag unions
+	/// are only copied once either state modifies them.
 	std::shared_ptr<KnownState> copy() const { return std::make_shared<KnownState>(*this); }
 
 	/// @returns true if the knowledge about the state of both objects is (known to be) equal.
@@ -133,10 +139,10 @@ public:
 	void clearTagUnions();
 
 	int stackHeight() const { return m_stackHeight; }
-	std::map<int, Id> const& stackElements() const { return m_stackElements; }
+	StackElements const& stackElements() const { return m_stackElements; }
 	ExpressionClasses& expressionClasses() const { return *m_expressionClasses; }
 
-	std::map<Id, Id> const& storageContent() const { return m_storageContent; }
+	Content const& storageContent() const { return m_storageContent; }
 
 private:
 	/// Assigns a new equivalence class to the next sequence number of the given stack element.
@@ -165,20 +171,24 @@ private:
 	/// Current stack height, can be negative.
 	int m_stackHeight = 0;
 	/// Current stack layout, mapping stack height -> equivalence class
-	std::map<int, Id> m_stackElements;
+	StackElements m_stackElements;
 	/// Current sequence number, this is incremented with each modification to storage or memory.
 	unsigned m_sequenceNumber = 1;
 	/// Knowledge about storage content.
-	std::map<Id, Id> m_storageContent;
+	Content m_storageContent;
 	/// Knowledge about memory content. Keys are memory addresses, note that the values overlap
 	/// and are not contained here if they are not completely known.
-	std::map<Id, Id> m_memoryContent;
-	/// Keeps record of all Keccak-256 hashes that are computed.
-	std::map<std::vector<Id>, Id> m_knownKeccak256Hashes;
+	Content m_memoryContent;
+	/// Keeps record of all Keccak-256 hashes that are computed, shared with copies of this state
+	/// until either is modified.
+	std::shared_ptr<std::map<std::vector<Id>, Id>> m_knownKeccak256Hashes =
+		std::make_shared<std::map<std::vector<Id>, Id>>();
 	/// Structure containing the classes of equivalent expressions.
 	std::shared_ptr<ExpressionClasses> m_expressionClasses;
-	/// Container for unions of tags stored on the stack.
-	boost::bimap<Id, std::set<u256>> m_tagUnions;
+	/// Container for unions of tags stored on the stack, shared with copies of this state until
+	/// either is modified.
+	std::shared_ptr<boost::bimap<Id, std::set<u256>>> m_tagUnions =
+		std::make_shared<boost::bimap<Id, std::set<u256>>>();
 };
 
 }
@@ -28,8 +28,8 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::evmasm;
 
-PathGasMeter::PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion):
-	m_items(_items), m_evmVersion(_evmVersion)
+PathGasMeter::PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion, size_t _maxSteps):
+	m_items(_items), m_evmVersion(_evmVersion), m_maxSteps(_maxSteps)
 {
 	for (size_t i = 0; i < m_items.size(); ++i)
 		if (m_items[i].type() == Tag)
@@ -52,15 +52,24 @@ GasMeter::GasConsumption PathGasMeter::estimateMax(
 	return gas;
 }
 
+PathGasMeter::PathKey PathGasMeter::key(GasPath const& _path)
+{
+	PathKey key{_path.index, {}};
+	for (GasCallFrame const& frame: _path.callStack)
+		key.second.push_back(frame.callSite);
+	return key;
+}
+
 void PathGasMeter::queue(std::unique_ptr<GasPath>&& _newPath)
 {
+	PathKey pathKey = key(*_newPath);
 	if (
-		m_highestGasUsagePerJumpdest.count(_newPath->index) &&
-		_newPath->gas < m_highestGasUsagePerJumpdest.at(_newPath->index)
+		m_highestGasUsagePerJumpdest.count(pathKey) &&
+		_newPath->gas < m_highestGasUsagePerJumpdest.at(pathKey)
 	)
 		return;
-	m_highestGasUsagePerJumpdest[_newPath->index] = _newPath->gas;
-	m_queue[_newPath->index] = move(_newPath);
+	m_highestGasUsagePerJumpdest[pathKey] = _newPath->gas;
+	m_queue[move(pathKey)] = move(_newPath);
 }
 
 GasMeter::GasConsumption PathGasMeter::handleQueueItem()
@@ -85,6 +94,9 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 	set<u256> jumpTags;
 	for (; index < m_items.size() && !gas.isInfinite; ++index)
 	{
+		if (++m_steps > m_maxSteps)
+			return GasMeter::GasConsumption::infinite();
+
 		bool branchStops = false;
 		jumpTags.clear();
 		AssemblyItem const& item = m_items.at(index);
@@ -128,7 +140,22 @@ GasMeter::GasConsumption PathGasMeter::handleQueueItem()
 			newPath->gas = gas;
 			newPath->largestMemoryAccess = meter.largestMemoryAccess();
 			newPath->state = state->copy();
-			newPath->visitedJumpdests = path->visitedJumpdests;
+			newPath->callStack = path->callStack;
+			if (item.getJumpType() == AssemblyItem::JumpType::IntoFunction)
+			{
+				for (GasCallFrame const& frame: path->callStack)
+					if (frame.entry == newPath->index)
+						// Recursion
+						return GasMeter::GasConsumption::infinite();
+				newPath->callStack.push_back({index, newPath->index, path->visitedJumpdests});
+			}
+			else if (item.getJumpType() == AssemblyItem::JumpType::OutOfFunction && !path->callStack.empty())
+			{
+				newPath->visitedJumpdests = move(newPath->callStack.back().callerVisitedJumpdests);
+				newPath->callStack.pop_back();
+			}
+			else
+				newPath->visitedJumpdests = path->visitedJumpdests;
 			queue(move(newPath));
 		}
 
@@ -35,24 +35,48 @@ namespace solidity::evmasm
 
 class KnownState;
 
+/// A function that was entered on a gas path via a jump into a function.
+struct GasCallFrame
+{
+	/// Index of the jump into the function.
+	size_t callSite = 0;
+	/// Index of the tag the function starts at.
+	size_t entry = 0;
+	/// Jumpdests visited by the caller before the call.
+	std::set<size_t> callerVisitedJumpdests;
+};
+
 struct GasPath
 {
 	size_t index = 0;
 	std::shared_ptr<KnownState> state;
 	u256 largestMemoryAccess;
 	GasMeter::GasConsumption gas;
+	/// Jumpdests visited inside the innermost function on this path.
 	std::set<size_t> visitedJumpdests;
+	std::vector<GasCallFrame> callStack;
 };
 
 /**
  * Computes an upper bound on the gas usage of a computation starting at a certain position in
  * a list of AssemblyItems in a given state until the computation stops.
  * Can be used to estimate the gas usage of functions on any given input.
+ *
+ * Jumps into and out of functions are tracked, so that a function can be called several times
+ * on a path. Any other repeated visit of a jumpdest is treated as a loop and results in an
+ * infinite estimate, as does recursion or exceeding the exploration budget.
  */
 class PathGasMeter
 {
 public:
-	explicit PathGasMeter(AssemblyItems const& _items, langutil::EVMVersion _evmVersion);
+	/// Default maximum number of assembly items processed during a single estimation.
+	static size_t constexpr c_defaultMaxSteps = 100000;
+
+	explicit PathGasMeter(
+		AssemblyItems const& _items,
+		langutil::EVMVersion _evmVersion,
+		size_t _maxSteps = c_defaultMaxSteps
+	);
 
 	GasMeter::GasConsumption estimateMax(size_t _startIndex, std::shared_ptr<KnownState> const& _state);
 
@@ -60,10 +84,11 @@ public:
 		AssemblyItems const& _items,
 		langutil::EVMVersion _evmVersion,
 		size_t _startIndex,
-		std::shared_ptr<KnownState> const& _state
+		std::shared_ptr<KnownState> const& _state,
+		size_t _maxSteps = c_defaultMaxSteps
 	)
 	{
-		return PathGasMeter(_items, _evmVersion).estimateMax(_startIndex, _state);
+		return PathGasMeter(_items, _evmVersion, _maxSteps).estimateMax(_startIndex, _state);
 	}
 
 private:
@@ -74,13 +99,19 @@ private:
 	void queue(std::unique_ptr<GasPath>&& _newPath);
 	GasMeter::GasConsumption handleQueueItem();
 
+	/// Jumpdest together with the call sites of the functions it is reached through.
+	using PathKey = std::pair<size_t, std::vector<size_t>>;
+	static PathKey key(GasPath const& _path);
+
 	/// Map of jumpdest -> gas path, so not really a queue. We only have one queued up
-	/// item per jumpdest, because of the behaviour of `queue` above.
-	std::map<size_t, std::unique_ptr<GasPath>> m_queue;
-	std::map<size_t, GasMeter::GasConsumption> m_highestGasUsagePerJumpdest;
+	/// item per jumpdest and call stack, because of the behaviour of `queue` above.
+	std::map<PathKey, std::unique_ptr<GasPath>> m_queue;
+	std::map<PathKey, GasMeter::GasConsumption> m_highestGasUsagePerJumpdest;
 	std::map<u256, size_t> m_tagPositions;
 	AssemblyItems const& m_items;
 	langutil::EVMVersion m_evmVersion;
+	size_t m_maxSteps;
+	size_t m_steps = 0;
 };
 
 }
@@ -96,15 +96,6 @@ struct SimplePeepholeOptimizerMethod
 	}
 };
 
-struct Identity: SimplePeepholeOptimizerMethod<Identity, 1>
-{
-	static bool applySimple(AssemblyItem const& _item, std::back_insert_iterator<AssemblyItems> _out)
-	{
-		*_out = _item;
-		return true;
-	}
-};
-
 struct PushPop: SimplePeepholeOptimizerMethod<PushPop, 2>
 {
 	static bool applySimple(AssemblyItem const& _push, AssemblyItem const& _pop, std::back_insert_iterator<AssemblyItems>)
@@ -334,6 +325,18 @@ struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd, 3>
 	}
 };
 
+/// @returns true if the code after @a _item up to the next tag cannot be reached.
+bool endsReachableCode(AssemblyItem const& _item)
+{
+	return
+		_item == Instruction::JUMP ||
+		_item == Instruction::RETURN ||
+		_item == Instruction::STOP ||
+		_item == Instruction::INVALID ||
+		_item == Instruction::SELFDESTRUCT ||
+		_item == Instruction::REVERT;
+}
+
 /// Removes everything after a JUMP (or similar) until the next JUMPDEST.
 struct UnreachableCode
 {
@@ -343,14 +346,7 @@ struct UnreachableCode
 		auto end = _state.items.end();
 		if (it == end)
 			return false;
-		if (
-			it[0] != Instruction::JUMP &&
-			it[0] != Instruction::RETURN &&
-			it[0] != Instruction::STOP &&
-			it[0] != Instruction::INVALID &&
-			it[0] != Instruction::SELFDESTRUCT &&
-			it[0] != Instruction::REVERT
-		)
+		if (!endsReachableCode(it[0]))
 			return false;
 
 		ptrdiff_t i = 1;
@@ -367,45 +363,188 @@ struct UnreachableCode
 	}
 };
 
-void applyMethods(OptimiserState&)
+/// The largest window of the methods above. UnreachableCode looks further ahead, but only
+/// fails to apply if the item following the jump is a tag.
+size_t constexpr c_maxWindowSize = 4;
+
+bool applyMethods(OptimiserState&)
 {
-	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
+	return false;
 }
 
 template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
+bool applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
 {
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
+	return Method::apply(_state) || applyMethods(_state, _other...);
 }
 
-size_t numberOfPops(AssemblyItems const& _items)
+/// The items as a doubly linked list, so that a range of items can be replaced in constant time.
+/// Replaced nodes keep their links, which allows to undo replacements in reverse order.
+struct ItemList
 {
-	return static_cast<size_t>(std::count(_items.begin(), _items.end(), Instruction::POP));
-}
+	/// Index of the node that is both before the first and after the last item.
+	static size_t constexpr sentinel = 0;
+
+	explicit ItemList(AssemblyItems& _items)
+	{
+		nodes.reserve(_items.size() + 1);
+		nodes.emplace_back(UndefinedItem);
+		for (AssemblyItem& item: _items)
+			nodes.emplace_back(std::move(item));
+		for (size_t i = 0; i < nodes.size(); ++i)
+		{
+			next.push_back((i + 1) % nodes.size());
+			previous.push_back((i + nodes.size() - 1) % nodes.size());
+		}
+		removed.resize(nodes.size(), false);
+	}
+
+	size_t append(AssemblyItem _item)
+	{
+		nodes.emplace_back(std::move(_item));
+		next.push_back(sentinel);
+		previous.push_back(sentinel);
+		removed.push_back(false);
+		return nodes.size() - 1;
+	}
+
+	void link(size_t _first, size_t _second)
+	{
+		next[_first] = _second;
+		previous[_second] = _first;
+	}
+
+	AssemblyItems nodes;
+	std::vector<size_t> next;
+	std::vector<size_t> previous;
+	std::vector<bool> removed;
+};
+
+/// Replacement of the nodes from @a first to @a last, which were between @a before and @a after.
+struct Replacement
+{
+	size_t before;
+	size_t first;
+	size_t last;
+	size_t after;
+};
 
 }
 
 bool PeepholeOptimiser::optimise()
 {
-	OptimiserState state {m_items, 0, std::back_inserter(m_optimisedItems)};
-	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(), OpPop(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
-			DupSwap(), IsZeroIsZeroJumpI(), JumpToNext(), UnreachableCode(),
-			TagConjunctions(), TruthyAnd(), Identity()
-		);
-	if (m_optimisedItems.size() < m_items.size() || (
-		m_optimisedItems.size() == m_items.size() && (
-			evmasm::bytesRequired(m_optimisedItems, 3) < evmasm::bytesRequired(m_items, 3) ||
-			numberOfPops(m_optimisedItems) > numberOfPops(m_items)
-		)
-	))
+	// Every pass applies the methods from left to right without looking at its own replacements,
+	// and is only kept if it improves the code. The methods only look at a small window of items,
+	// so an item whose window did not change during the previous pass cannot match in the next
+	// pass. Because of that, the next pass only visits the replacements and the items in front of
+	// them. This reaches the fixpoint of running complete passes in time roughly proportional to
+	// the number of replacements.
+	ItemList list(m_items);
+	m_items.clear();
+
+	std::vector<size_t> worklist;
+	for (size_t node = list.next[ItemList::sentinel]; node != ItemList::sentinel; node = list.next[node])
+		worklist.push_back(node);
+	// The pass in which the node is visited next, the sentinel is never visited.
+	std::vector<size_t> queuedFor(list.nodes.size(), 1);
+	queuedFor[ItemList::sentinel] = 0;
+
+	bool changed = false;
+	AssemblyItems window;
+	AssemblyItems replacement;
+	for (size_t pass = 1; !worklist.empty(); ++pass)
 	{
-		m_items = std::move(m_optimisedItems);
-		return true;
+		std::vector<size_t> nextWorklist;
+		std::vector<Replacement> replacements;
+		ptrdiff_t sizeDifference = 0;
+		ptrdiff_t bytesDifference = 0;
+		ptrdiff_t popsDifference = 0;
+		for (size_t node: worklist)
+		{
+			if (list.removed[node])
+				continue;
+
+			window.clear();
+			for (size_t n = node; n != ItemList::sentinel; n = list.next[n])
+			{
+				if (window.size() >= c_maxWindowSize && (!endsReachableCode(window.front()) || list.nodes[n].type() == Tag))
+					break;
+				window.push_back(list.nodes[n]);
+			}
+			replacement.clear();
+			OptimiserState state{window, 0, std::back_inserter(replacement)};
+			if (!applyMethods(
+				state,
+				PushPop(), OpPop(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
+				DupSwap(), IsZeroIsZeroJumpI(), JumpToNext(), UnreachableCode(),
+				TagConjunctions(), TruthyAnd()
+			))
+				continue;
+
+			Replacement replaced{list.previous[node], node, node, ItemList::sentinel};
+			list.removed[node] = true;
+			for (size_t i = 1; i < state.i; ++i)
+			{
+				replaced.last = list.next[replaced.last];
+				list.removed[replaced.last] = true;
+			}
+			replaced.after = list.next[replaced.last];
+			replacements.push_back(replaced);
+
+			sizeDifference += static_cast<ptrdiff_t>(replacement.size()) - static_cast<ptrdiff_t>(state.i);
+			bytesDifference += static_cast<ptrdiff_t>(bytesRequired(replacement, 3));
+			popsDifference += std::count(replacement.begin(), replacement.end(), Instruction::POP);
+			for (size_t i = 0; i < state.i; ++i)
+			{
+				bytesDifference -= static_cast<ptrdiff_t>(window[i].bytesRequired(3));
+				if (window[i] == Instruction::POP)
+					popsDifference--;
+			}
+
+			// The items in front of the replacement have to be visited in the next pass, since their
+			// window changed. Stop at items that are already queued to keep the worklist in order.
+			std::vector<size_t> inFront;
+			for (
+				size_t n = replaced.before;
+				n != ItemList::sentinel && queuedFor[n] != pass + 1 && inFront.size() + 1 < c_maxWindowSize;
+				n = list.previous[n]
+			)
+				inFront.push_back(n);
+			for (auto it = inFront.rbegin(); it != inFront.rend(); ++it)
+			{
+				queuedFor[*it] = pass + 1;
+				nextWorklist.push_back(*it);
+			}
+
+			size_t last = replaced.before;
+			for (AssemblyItem& item: replacement)
+			{
+				size_t added = list.append(std::move(item));
+				queuedFor.push_back(pass + 1);
+				nextWorklist.push_back(added);
+				list.link(last, added);
+				last = added;
+			}
+			list.link(last, replaced.after);
+		}
+
+		if (
+			sizeDifference > 0 ||
+			(sizeDifference == 0 && bytesDifference >= 0 && popsDifference <= 0)
+		)
+		{
+			for (auto it = replacements.rbegin(); it != replacements.rend(); ++it)
+			{
+				list.link(it->before, it->first);
+				list.link(it->last, it->after);
+			}
+			break;
+		}
+		changed = true;
+		worklist = std::move(nextWorklist);
 	}
-	else
-		return false;
+
+	for (size_t node = list.next[ItemList::sentinel]; node != ItemList::sentinel; node = list.next[node])
+		m_items.emplace_back(std::move(list.nodes[node]));
+	return changed;
 }
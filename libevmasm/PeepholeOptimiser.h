@@ -44,11 +44,12 @@ public:
 	explicit PeepholeOptimiser(AssemblyItems& _items): m_items(_items) {}
 	virtual ~PeepholeOptimiser() = default;
 
+	/// Applies the optimisations until none of them is applicable anymore.
+	/// @returns true if the items were changed.
 	bool optimise();
 
 private:
 	AssemblyItems& m_items;
-	AssemblyItems m_optimisedItems;
 };
 
 }
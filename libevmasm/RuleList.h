@@ -27,6 +27,7 @@
 #include <libevmasm/SimplificationRule.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Word256.h>
 
 #include <boost/multiprecision/detail/min_max.hpp>
 
@@ -40,21 +41,11 @@
 namespace solidity::evmasm
 {
 
-template <class S> S divWorkaround(S const& _a, S const& _b)
+/// Constants are folded and shifted on util::Word256, which, unlike the operations on
+/// bigint and s256, does not allocate.
+template <class S> util::Word256 toWord256(S const& _value)
 {
-	return (S)(bigint(_a) / bigint(_b));
-}
-
-template <class S> S modWorkaround(S const& _a, S const& _b)
-{
-	return (S)(bigint(_a) % bigint(_b));
-}
-
-// This works around a bug fixed with Boost 1.64.
-// https://www.boost.org/doc/libs/1_68_0/libs/multiprecision/doc/html/boost_multiprecision/map/hist.html#boost_multiprecision.map.hist.multiprecision_2_3_1_boost_1_64
-template <class S> S shlWorkaround(S const& _x, unsigned _amount)
-{
-	return u256((bigint(_x) << _amount) & u256(-1));
+	return util::Word256(_value);
 }
 
 // simplificationRuleList below was split up into parts to prevent
@@ -74,18 +65,18 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart1(
 	return std::vector<SimplificationRule<Pattern>>{
 		// arithmetic on constants
 		{Builtins::ADD(A, B), [=]{ return A.d() + B.d(); }},
-		{Builtins::MUL(A, B), [=]{ return A.d() * B.d(); }},
+		{Builtins::MUL(A, B), [=]{ return Word(toWord256(A.d()) * toWord256(B.d())); }},
 		{Builtins::SUB(A, B), [=]{ return A.d() - B.d(); }},
-		{Builtins::DIV(A, B), [=]{ return B.d() == 0 ? 0 : divWorkaround(A.d(), B.d()); }},
-		{Builtins::SDIV(A, B), [=]{ return B.d() == 0 ? 0 : s2u(divWorkaround(u2s(A.d()), u2s(B.d()))); }},
-		{Builtins::MOD(A, B), [=]{ return B.d() == 0 ? 0 : modWorkaround(A.d(), B.d()); }},
-		{Builtins::SMOD(A, B), [=]{ return B.d() == 0 ? 0 : s2u(modWorkaround(u2s(A.d()), u2s(B.d()))); }},
-		{Builtins::EXP(A, B), [=]{ return Word(boost::multiprecision::powm(bigint(A.d()), bigint(B.d()), bigint(1) << Pattern::WordSize)); }},
+		{Builtins::DIV(A, B), [=]{ return Word(toWord256(A.d()) / toWord256(B.d())); }},
+		{Builtins::SDIV(A, B), [=]{ return Word(util::signedDiv(toWord256(A.d()), toWord256(B.d()))); }},
+		{Builtins::MOD(A, B), [=]{ return Word(toWord256(A.d()) % toWord256(B.d())); }},
+		{Builtins::SMOD(A, B), [=]{ return Word(util::signedMod(toWord256(A.d()), toWord256(B.d()))); }},
+		{Builtins::EXP(A, B), [=]{ return Word(util::power(toWord256(A.d()), toWord256(B.d()))); }},
 		{Builtins::NOT(A), [=]{ return ~A.d(); }},
 		{Builtins::LT(A, B), [=]() -> Word { return A.d() < B.d() ? 1 : 0; }},
 		{Builtins::GT(A, B), [=]() -> Word { return A.d() > B.d() ? 1 : 0; }},
-		{Builtins::SLT(A, B), [=]() -> Word { return u2s(A.d()) < u2s(B.d()) ? 1 : 0; }},
-		{Builtins::SGT(A, B), [=]() -> Word { return u2s(A.d()) > u2s(B.d()) ? 1 : 0; }},
+		{Builtins::SLT(A, B), [=]() -> Word { return util::signedLessThan(toWord256(A.d()), toWord256(B.d())) ? 1 : 0; }},
+		{Builtins::SGT(A, B), [=]() -> Word { return util::signedLessThan(toWord256(B.d()), toWord256(A.d())) ? 1 : 0; }},
 		{Builtins::EQ(A, B), [=]() -> Word { return A.d() == B.d() ? 1 : 0; }},
 		{Builtins::ISZERO(A), [=]() -> Word { return A.d() == 0 ? 1 : 0; }},
 		{Builtins::AND(A, B), [=]{ return A.d() & B.d(); }},
@@ -97,19 +88,13 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart1(
 				0 :
 				(B.d() >> unsigned(8 * (Pattern::WordSize / 8 - 1 - A.d()))) & 0xff;
 		}},
-		{Builtins::ADDMOD(A, B, C), [=]{ return C.d() == 0 ? 0 : Word((bigint(A.d()) + bigint(B.d())) % C.d()); }},
-		{Builtins::MULMOD(A, B, C), [=]{ return C.d() == 0 ? 0 : Word((bigint(A.d()) * bigint(B.d())) % C.d()); }},
-		{Builtins::SIGNEXTEND(A, B), [=]() -> Word {
-			if (A.d() >= Pattern::WordSize / 8 - 1)
-				return B.d();
-			unsigned testBit = unsigned(A.d()) * 8 + 7;
-			Word mask = (Word(1) << testBit) - 1;
-			return boost::multiprecision::bit_test(B.d(), testBit) ? B.d() | ~mask : B.d() & mask;
-		}},
+		{Builtins::ADDMOD(A, B, C), [=]{ return Word(util::addMod(toWord256(A.d()), toWord256(B.d()), toWord256(C.d()))); }},
+		{Builtins::MULMOD(A, B, C), [=]{ return Word(util::mulMod(toWord256(A.d()), toWord256(B.d()), toWord256(C.d()))); }},
+		{Builtins::SIGNEXTEND(A, B), [=]{ return Word(util::signExtend(toWord256(A.d()), toWord256(B.d()))); }},
 		{Builtins::SHL(A, B), [=]{
 			if (A.d() >= Pattern::WordSize)
 				return Word(0);
-			return shlWorkaround(B.d(), unsigned(A.d()));
+			return Word(toWord256(B.d()) << unsigned(A.d()));
 		}},
 		{Builtins::SHR(A, B), [=]{
 			if (A.d() >= Pattern::WordSize)
@@ -453,7 +438,7 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart7(
 		// SHR(B, SHL(A, X)) -> AND(SH[L/R]([B - A / A - B], X), Mask)
 		Builtins::SHR(B, Builtins::SHL(A, X)),
 		[=]() -> Pattern {
-			Word mask = shlWorkaround(~Word(0), unsigned(A.d())) >> unsigned(B.d());
+			Word mask = Word(toWord256(~Word(0)) << unsigned(A.d())) >> unsigned(B.d());
 
 			if (A.d() > B.d())
 				return Builtins::AND(Builtins::SHL(A.d() - B.d(), X), mask);
@@ -470,7 +455,7 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart7(
 		// SHL(B, SHR(A, X)) -> AND(SH[L/R]([B - A / A - B], X), Mask)
 		Builtins::SHL(B, Builtins::SHR(A, X)),
 		[=]() -> Pattern {
-			Word mask = shlWorkaround((~Word(0)) >> unsigned(A.d()), unsigned(B.d()));
+			Word mask = Word(toWord256((~Word(0)) >> unsigned(A.d())) << unsigned(B.d()));
 
 			if (A.d() > B.d())
 				return Builtins::AND(Builtins::SHR(A.d() - B.d(), X), mask);
@@ -489,7 +474,7 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart7(
 		auto replacement = [=]() -> Pattern {
 			Word mask =
 				instr == Instruction::SHL ?
-				shlWorkaround(A.d(), unsigned(B.d())) :
+				Word(toWord256(A.d()) << unsigned(B.d())) :
 				A.d() >> unsigned(B.d());
 			return Builtins::AND(shiftOp(B.d(), X), std::move(mask));
 		};
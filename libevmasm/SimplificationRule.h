@@ -24,6 +24,8 @@
 #include <libevmasm/Instruction.h>
 #include <libsolutil/CommonData.h>
 #include <functional>
+#include <map>
+#include <vector>
 
 namespace solidity::evmasm
 {
@@ -51,6 +53,69 @@ struct SimplificationRule
 	std::function<bool()> feasible;
 };
 
+/**
+ * Simplification rules grouped by the instruction at the root of their pattern and, for a given
+ * expression, narrowed down further by the kinds of its arguments: A rule whose pattern requires
+ * a constant or a certain operation as an argument can only match if the argument is one.
+ * The list of candidate rules is computed once for each combination of argument kinds, so that
+ * most expressions without a matching rule do not try a single pattern.
+ */
+template <class Pattern>
+class SimplificationRuleIndex
+{
+public:
+	using Rule = SimplificationRule<Pattern>;
+	/// Kind of a pattern argument or an expression argument: Patterns use @a c_any for arguments
+	/// that match anything, expressions use it for arguments that are neither a constant nor
+	/// the result of an instruction.
+	using ArgumentKind = uint16_t;
+	static ArgumentKind constexpr c_any = 0;
+	static ArgumentKind constexpr c_constant = 1;
+	static ArgumentKind operation(Instruction _instruction)
+	{
+		return static_cast<ArgumentKind>(2 + static_cast<uint8_t>(_instruction));
+	}
+
+	/// Adds a rule whose pattern is an application of @a _instruction to arguments of the
+	/// given kinds.
+	void add(Rule _rule, Instruction _instruction, std::vector<ArgumentKind> _argumentKinds)
+	{
+		m_rules[static_cast<uint8_t>(_instruction)].emplace_back(std::move(_rule), std::move(_argumentKinds));
+		m_candidates[static_cast<uint8_t>(_instruction)].clear();
+	}
+
+	bool empty(Instruction _instruction) const { return m_rules[static_cast<uint8_t>(_instruction)].empty(); }
+
+	/// @returns the rules, in the order they were added, that might match an application of
+	/// @a _instruction to arguments of the given kinds.
+	std::vector<Rule const*> const& candidates(
+		Instruction _instruction,
+		std::vector<ArgumentKind> const& _argumentKinds
+	)
+	{
+		auto& candidates = m_candidates[static_cast<uint8_t>(_instruction)];
+		auto it = candidates.find(_argumentKinds);
+		if (it != candidates.end())
+			return it->second;
+
+		std::vector<Rule const*> rules;
+		for (auto const& [rule, argumentKinds]: m_rules[static_cast<uint8_t>(_instruction)])
+		{
+			bool compatible = true;
+			for (size_t i = 0; i < argumentKinds.size() && i < _argumentKinds.size(); ++i)
+				if (argumentKinds[i] != c_any && argumentKinds[i] != _argumentKinds[i])
+					compatible = false;
+			if (compatible)
+				rules.push_back(&rule);
+		}
+		return candidates.emplace(_argumentKinds, std::move(rules)).first->second;
+	}
+
+private:
+	std::vector<std::pair<Rule, std::vector<ArgumentKind>>> m_rules[256];
+	std::map<std::vector<ArgumentKind>, std::vector<Rule const*>> m_candidates[256];
+};
+
 template <typename Pattern>
 struct EVMBuiltins
 {
@@ -43,14 +43,31 @@ SimplificationRule<Pattern> const* Rules::findFirstMatch(
 	ExpressionClasses const& _classes
 )
 {
+	using Index = SimplificationRuleIndex<Pattern>;
+
 	resetMatchGroups();
 
 	assertThrow(_expr.item, OptimizerException, "");
-	for (auto const& rule: m_rules[uint8_t(_expr.item->instruction())])
+	if (m_rules.empty(_expr.item->instruction()))
+		return nullptr;
+
+	m_argumentKinds.clear();
+	for (ExpressionClasses::Id argument: _expr.arguments)
+	{
+		AssemblyItem const* item = _classes.representative(argument).item;
+		if (item && item->type() == Push)
+			m_argumentKinds.push_back(Index::c_constant);
+		else if (item && item->type() == Operation)
+			m_argumentKinds.push_back(Index::operation(item->instruction()));
+		else
+			m_argumentKinds.push_back(Index::c_any);
+	}
+
+	for (auto const* rule: m_rules.candidates(_expr.item->instruction(), m_argumentKinds))
 	{
-		if (rule.pattern.matches(_expr, _classes))
-			if (!rule.feasible || rule.feasible())
-				return &rule;
+		if (rule->pattern.matches(_expr, _classes))
+			if (!rule->feasible || rule->feasible())
+				return rule;
 
 		resetMatchGroups();
 	}
@@ -59,7 +76,7 @@ SimplificationRule<Pattern> const* Rules::findFirstMatch(
 
 bool Rules::isInitialized() const
 {
-	return !m_rules[uint8_t(Instruction::ADD)].empty();
+	return !m_rules.empty(Instruction::ADD);
 }
 
 void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
@@ -70,7 +87,17 @@ void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
 
 void Rules::addRule(SimplificationRule<Pattern> const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	using Index = SimplificationRuleIndex<Pattern>;
+
+	vector<Index::ArgumentKind> argumentKinds;
+	for (Pattern const& argument: _rule.pattern.arguments())
+		if (argument.type() == Push)
+			argumentKinds.push_back(Index::c_constant);
+		else if (argument.type() == Operation)
+			argumentKinds.push_back(Index::operation(argument.instruction()));
+		else
+			argumentKinds.push_back(Index::c_any);
+	m_rules.add(_rule, _rule.pattern.instruction(), move(argumentKinds));
 }
 
 Rules::Rules()
@@ -38,6 +38,28 @@ ErrorReporter& ErrorReporter::operator=(ErrorReporter const& _errorReporter)
 	return *this;
 }
 
+bool ErrorReporter::appendWithinLimits(ErrorList const& _errorList)
+{
+	unsigned warningCount = 0;
+	unsigned errorCount = 0;
+	for (auto const& error: _errorList)
+		if (error->type() == Error::Type::Warning)
+			++warningCount;
+		else
+			++errorCount;
+
+	if (
+		m_warningCount + warningCount >= c_maxWarningsAllowed ||
+		m_errorCount + errorCount > c_maxErrorsAllowed
+	)
+		return false;
+
+	m_warningCount += warningCount;
+	m_errorCount += errorCount;
+	m_errorList += _errorList;
+	return true;
+}
+
 void ErrorReporter::warning(ErrorId _error, string const& _description)
 {
 	error(_error, Error::Type::Warning, SourceLocation(), _description);
@@ -52,6 +52,10 @@ public:
 		m_errorList += _errorList;
 	}
 
+	/// Appends the errors collected by another reporter and counts them as if they were reported here.
+	/// @returns false and appends nothing if this reaches the maximum number of errors or warnings.
+	bool appendWithinLimits(ErrorList const& _errorList);
+
 	void warning(ErrorId _error, std::string const& _description);
 
 	void warning(ErrorId _error, SourceLocation const& _location, std::string const& _description);
@@ -20,6 +20,7 @@
 
 #include <libsolutil/CommonIO.h>
 
+#include <cvc4/base/configuration.h>
 #include <cvc4/util/bitvector.h>
 
 using namespace std;
@@ -27,6 +28,11 @@ using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::smtutil;
 
+string CVC4Interface::version()
+{
+	return CVC4::Configuration::getVersionString();
+}
+
 CVC4Interface::CVC4Interface(optional<unsigned> _queryTimeout):
 	SolverInterface(_queryTimeout),
 	m_solver(&m_context)
@@ -37,6 +43,7 @@ CVC4Interface::CVC4Interface(optional<unsigned> _queryTimeout):
 void CVC4Interface::reset()
 {
 	m_variables.clear();
+	m_translations.clear();
 	m_solver.reset();
 	m_solver.setOption("produce-models", true);
 	if (m_queryTimeout)
@@ -58,6 +65,8 @@ void CVC4Interface::pop()
 void CVC4Interface::declareVariable(string const& _name, SortPointer const& _sort)
 {
 	smtAssert(_sort, "");
+	if (m_variables.count(_name))
+		m_translations.clear();
 	m_variables[_name] = m_context.mkVar(_name.c_str(), cvc4Sort(*_sort));
 }
 
@@ -121,7 +130,21 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 	return make_pair(result, values);
 }
 
+void CVC4Interface::interrupt()
+{
+	m_solver.interrupt();
+}
+
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
+{
+	if (CVC4::Expr const* translation = m_translations.find(_expr))
+		return *translation;
+	CVC4::Expr translation = translate(_expr);
+	m_translations.insert(_expr, translation);
+	return translation;
+}
+
+CVC4::Expr CVC4Interface::translate(Expression const& _expr)
 {
 	// Variable
 	if (_expr.arguments.empty() && m_variables.count(_expr.name))
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <libsmtutil/ExpressionCache.h>
 #include <libsmtutil/SolverInterface.h>
 #include <boost/noncopyable.hpp>
 
@@ -42,6 +43,9 @@ class CVC4Interface: public SolverInterface, public boost::noncopyable
 public:
 	CVC4Interface(std::optional<unsigned> _queryTimeout = {});
 
+	/// @returns the version of the CVC4 library in use.
+	static std::string version();
+
 	void reset() override;
 
 	void push() override;
@@ -51,15 +55,20 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
 
 private:
 	CVC4::Expr toCVC4Expr(Expression const& _expr);
+	/// Translates @a _expr without using m_translations for @a _expr itself.
+	CVC4::Expr translate(Expression const& _expr);
 	CVC4::Type cvc4Sort(Sort const& _sort);
 	std::vector<CVC4::Type> cvc4Sort(std::vector<SortPointer> const& _sorts);
 
 	CVC4::ExprManager m_context;
 	CVC4::SmtEngine m_solver;
 	std::map<std::string, CVC4::Expr> m_variables;
+	/// Translations of the expressions that have arguments. Invalidated when a name is declared again.
+	ExpressionCache<CVC4::Expr> m_translations;
 
 	// CVC4 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
@@ -0,0 +1,119 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+#pragma once
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace solidity::smtutil
+{
+
+/**
+ * Cache for the translations of expressions into the representation of a solver.
+ * Since copies of an expression share their argument list (see ExpressionArguments),
+ * the translations are keyed by the identity of the argument list, the name and the sort,
+ * which makes it possible to translate shared subexpressions only once.
+ * Expressions without arguments are not cached.
+ * The cache does not keep the expressions alive: Entries of expressions that no longer
+ * exist are ignored and removed from time to time.
+ */
+template <class Translation>
+class ExpressionCache
+{
+public:
+	/// @returns the cached translation of @a _expr or nullptr if there is none.
+	Translation const* find(Expression const& _expr)
+	{
+		if (_expr.arguments.empty())
+			return nullptr;
+		auto it = m_entries.find(key(_expr));
+		if (it == m_entries.end())
+			return nullptr;
+		if (it->second.arguments.expired() || it->second.sort.expired())
+		{
+			m_entries.erase(it);
+			return nullptr;
+		}
+		return &it->second.translation;
+	}
+
+	void insert(Expression const& _expr, Translation _translation)
+	{
+		if (_expr.arguments.empty())
+			return;
+		if (m_entries.size() >= m_purgeThreshold)
+		{
+			for (auto it = m_entries.begin(); it != m_entries.end();)
+				if (it->second.arguments.expired() || it->second.sort.expired())
+					it = m_entries.erase(it);
+				else
+					++it;
+			m_purgeThreshold = std::max<size_t>(c_minPurgeThreshold, 2 * m_entries.size());
+		}
+		m_entries.insert_or_assign(key(_expr), Entry{_expr.arguments.shared(), _expr.sort, std::move(_translation)});
+	}
+
+	void clear() { m_entries.clear(); }
+
+private:
+	struct Key
+	{
+		void const* arguments;
+		void const* sort;
+		std::string name;
+
+		bool operator==(Key const& _other) const
+		{
+			return arguments == _other.arguments && sort == _other.sort && name == _other.name;
+		}
+	};
+	struct KeyHash
+	{
+		size_t operator()(Key const& _key) const
+		{
+			size_t seed = 0;
+			boost::hash_combine(seed, _key.arguments);
+			boost::hash_combine(seed, _key.sort);
+			return seed;
+		}
+	};
+	struct Entry
+	{
+		std::weak_ptr<std::vector<Expression> const> arguments;
+		std::weak_ptr<Sort> sort;
+		Translation translation;
+	};
+
+	static Key key(Expression const& _expr)
+	{
+		return {_expr.arguments.shared().get(), _expr.sort.get(), _expr.name};
+	}
+
+	static size_t constexpr c_minPurgeThreshold = 1024;
+
+	std::unordered_map<Key, Entry, KeyHash> m_entries;
+	size_t m_purgeThreshold = c_minPurgeThreshold;
+};
+
+}
@@ -0,0 +1,118 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/QueryCache.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+#include <libsolutil/Keccak256.h>
+
+#include <boost/algorithm/string/split.hpp>
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::smtutil;
+
+namespace fs = boost::filesystem;
+
+h256 QueryCache::key(string const& _solvers, string const& _query)
+{
+	return keccak256(_solvers + '\0' + _query);
+}
+
+optional<QueryCache::Entry> QueryCache::load(h256 const& _key) const
+{
+	fs::path path = entryPath(_key);
+	boost::system::error_code error;
+	if (!fs::is_regular_file(path, error))
+		return nullopt;
+
+	string content;
+	try
+	{
+		content = readFileAsString(path.string());
+	}
+	catch (FileNotFound const&)
+	{
+		return nullopt;
+	}
+	// Every line, including the last one, is terminated by a newline,
+	// so that truncated entries can be detected.
+	if (content.empty() || content.back() != '\n')
+		return nullopt;
+	content.pop_back();
+
+	vector<string> lines;
+	boost::split(lines, content, [](char _c) { return _c == '\n'; });
+	Entry entry;
+	if (lines.front() == "sat")
+		entry.first = CheckResult::SATISFIABLE;
+	else if (lines.front() == "unsat")
+		entry.first = CheckResult::UNSATISFIABLE;
+	else
+		return nullopt;
+	entry.second.assign(next(lines.begin()), lines.end());
+	return entry;
+}
+
+void QueryCache::store(h256 const& _key, CheckResult _result, vector<string> const& _values) const
+{
+	if (_result != CheckResult::SATISFIABLE && _result != CheckResult::UNSATISFIABLE)
+		return;
+	string content = _result == CheckResult::SATISFIABLE ? "sat\n" : "unsat\n";
+	for (string const& value: _values)
+	{
+		if (value.find('\n') != string::npos)
+			return;
+		content += value + "\n";
+	}
+
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (error)
+		return;
+
+	// Write to a temporary file first and rename it afterwards, so that concurrent
+	// compiler runs never see partially written entries.
+	fs::path path = entryPath(_key);
+	fs::path temporaryPath = fs::unique_path(path.string() + ".%%%%-%%%%-%%%%", error);
+	if (error)
+		return;
+	{
+		ofstream output(temporaryPath.string(), ios::out | ios::binary | ios::trunc);
+		output << content;
+		if (!output.good())
+		{
+			output.close();
+			fs::remove(temporaryPath, error);
+			return;
+		}
+	}
+	fs::rename(temporaryPath, path, error);
+	if (error)
+		fs::remove(temporaryPath, error);
+}
+
+fs::path QueryCache::entryPath(h256 const& _key) const
+{
+	return m_directory / (_key.hex() + ".smt2out");
+}
@@ -0,0 +1,73 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Persistent storage for the answers of SMT solvers.
+ */
+
+#pragma once
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace solidity::smtutil
+{
+
+/**
+ * Storage for the answers of SMT solvers to single queries, kept as one file per entry
+ * in a directory, so that the answers can be reused by later compiler runs.
+ * The key has to cover the query, the solvers and the timeout, see key().
+ * Only actual answers (SATISFIABLE or UNSATISFIABLE) are stored, since all other
+ * results may depend on the machine and its load.
+ * Entries that cannot be read are treated as missing and failures to write are ignored,
+ * so the cache never causes an analysis to fail.
+ */
+class QueryCache
+{
+public:
+	using Entry = std::pair<CheckResult, std::vector<std::string>>;
+
+	explicit QueryCache(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	/// @returns the key of @a _query, which is the full text of the query,
+	/// when it is sent to the solvers identified by @a _solvers.
+	static util::h256 key(std::string const& _solvers, std::string const& _query);
+
+	/// @returns the entry stored under @a _key or nullopt if there is no valid entry.
+	std::optional<Entry> load(util::h256 const& _key) const;
+	/// Stores the result @a _result and the values @a _values of the evaluated expressions
+	/// under @a _key, replacing any previous entry.
+	/// Does nothing unless @a _result is SATISFIABLE or UNSATISFIABLE.
+	void store(util::h256 const& _key, CheckResult _result, std::vector<std::string> const& _values) const;
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+
+	boost::filesystem::path m_directory;
+};
+
+}
@@ -24,8 +24,15 @@
 #ifdef HAVE_CVC4
 #include <libsmtutil/CVC4Interface.h>
 #endif
+#include <libsmtutil/QueryCache.h>
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -36,18 +43,31 @@ SMTPortfolio::SMTPortfolio(
 	map<h256, string> _smtlib2Responses,
 	frontend::ReadCallback::Callback _smtCallback,
 	[[maybe_unused]] SMTSolverChoice _enabledSolvers,
-	optional<unsigned> _queryTimeout
+	optional<unsigned> _queryTimeout,
+	bool _race,
+	shared_ptr<QueryCache> _queryCache
 ):
-	SolverInterface(_queryTimeout)
+	SolverInterface(_queryTimeout),
+	m_race(_race),
+	m_queryCache(move(_queryCache)),
+	m_solverNames("smtlib2")
 {
-	m_solvers.emplace_back(make_unique<SMTLib2Interface>(move(_smtlib2Responses), move(_smtCallback), m_queryTimeout));
+	auto smtlib2 = make_unique<SMTLib2Interface>(move(_smtlib2Responses), move(_smtCallback), m_queryTimeout);
+	m_smtlib2 = smtlib2.get();
+	m_solvers.emplace_back(move(smtlib2));
 #ifdef HAVE_Z3
 	if (_enabledSolvers.z3 && Z3Interface::available())
+	{
 		m_solvers.emplace_back(make_unique<Z3Interface>(m_queryTimeout));
+		m_solverNames += " z3 " + Z3Interface::version();
+	}
 #endif
 #ifdef HAVE_CVC4
 	if (_enabledSolvers.cvc4)
+	{
 		m_solvers.emplace_back(make_unique<CVC4Interface>(m_queryTimeout));
+		m_solverNames += " cvc4 " + CVC4Interface::version();
+	}
 #endif
 }
 
@@ -82,6 +102,35 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
 		s->addAssertion(_expr);
 }
 
+pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
+{
+	if (m_solvers.size() <= 1)
+		return crossCheck(_expressionsToEvaluate);
+
+	// The cache is only used together with in-process solvers. Answers to queries that are
+	// only sent via SMT-LIB2 are provided by the caller and are not stored.
+	optional<h256> cacheKey;
+	if (m_queryCache)
+	{
+		cacheKey = QueryCache::key(m_solverNames, m_smtlib2->dumpQuery(_expressionsToEvaluate));
+		if (auto entry = m_queryCache->load(*cacheKey))
+		{
+			// Only the in-process solvers are replaced by the cache. The SMT-LIB2 interface
+			// still receives the query, so that it is passed to the callback or reported as
+			// unhandled as without the cache.
+			pair<CheckResult, vector<string>> result{CheckResult::ERROR, {}};
+			mergeResult(result, m_smtlib2->check(_expressionsToEvaluate));
+			mergeResult(result, move(*entry));
+			return result;
+		}
+	}
+
+	auto result = m_race ? race(_expressionsToEvaluate) : crossCheck(_expressionsToEvaluate);
+	if (cacheKey)
+		m_queryCache->store(*cacheKey, result.first, result.second);
+	return result;
+}
+
 /*
  * Broadcasts the SMT query to all solvers and returns a single result.
  * This comment explains how this result is decided.
@@ -112,32 +161,145 @@ void SMTPortfolio::addAssertion(Expression const& _expr)
  *
  *   If all solvers return ERROR, the result is ERROR.
 */
-pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
+pair<CheckResult, vector<string>> SMTPortfolio::crossCheck(vector<Expression> const& _expressionsToEvaluate)
 {
-	CheckResult lastResult = CheckResult::ERROR;
-	vector<string> finalValues;
+	pair<CheckResult, vector<string>> result{CheckResult::ERROR, {}};
 	for (auto const& s: m_solvers)
 	{
-		CheckResult result;
-		vector<string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
-		if (solverAnswered(result))
+		mergeResult(result, s->check(_expressionsToEvaluate));
+		if (result.first == CheckResult::CONFLICTING)
+			break;
+	}
+	return result;
+}
+
+void SMTPortfolio::mergeResult(
+	pair<CheckResult, vector<string>>& _result,
+	pair<CheckResult, vector<string>> _solverResult
+)
+{
+	auto& [lastResult, finalValues] = _result;
+	auto& [result, values] = _solverResult;
+	if (solverAnswered(result))
+	{
+		if (!solverAnswered(lastResult))
 		{
-			if (!solverAnswered(lastResult))
+			lastResult = result;
+			finalValues = std::move(values);
+		}
+		else if (lastResult != result)
+			lastResult = CheckResult::CONFLICTING;
+	}
+	else if (result == CheckResult::UNKNOWN && lastResult == CheckResult::ERROR)
+		lastResult = result;
+}
+
+/*
+ * Sends the SMT query to all solvers concurrently. The first solver that answers
+ * the query (SAT or UNSAT) determines the result and the values, and the other
+ * solvers are cancelled. If no solver answers, the result is decided as in crossCheck:
+ * UNKNOWN if at least one solver returned UNKNOWN and ERROR otherwise.
+ *
+ * A cancelled solver is not queried if it has not started yet and its result or exception
+ * is ignored otherwise. Since a solver ignores an interrupt that arrives before its check
+ * has started, cancelled solvers are interrupted repeatedly until they have finished.
+ *
+ * The SMTLib2Interface is queried in the calling thread, since it may invoke the SMT callback.
+ * The solvers are only used by one thread at a time and all threads are joined
+ * before returning, so the solvers can be used as usual afterwards.
+ */
+pair<CheckResult, vector<string>> SMTPortfolio::race(vector<Expression> const& _expressionsToEvaluate)
+{
+	struct SolverState
+	{
+		bool cancelled = false;
+		bool finished = false;
+	};
+	vector<pair<CheckResult, vector<string>>> results(m_solvers.size(), {CheckResult::ERROR, {}});
+	vector<exception_ptr> errors(m_solvers.size());
+	vector<SolverState> states(m_solvers.size());
+	optional<size_t> winner;
+	mutex resultMutex;
+	condition_variable solverFinished;
+
+	auto runSolver = [&](size_t _index)
+	{
+		bool cancelled = false;
+		{
+			lock_guard<mutex> lock(resultMutex);
+			cancelled = states[_index].cancelled;
+		}
+		if (!cancelled)
+		{
+			pair<CheckResult, vector<string>> result{CheckResult::ERROR, {}};
+			exception_ptr error;
+			try
+			{
+				result = m_solvers[_index]->check(_expressionsToEvaluate);
+			}
+			catch (...)
 			{
-				lastResult = result;
-				finalValues = std::move(values);
+				error = current_exception();
 			}
-			else if (lastResult != result)
+
+			lock_guard<mutex> lock(resultMutex);
+			if (!states[_index].cancelled)
 			{
-				lastResult = CheckResult::CONFLICTING;
-				break;
+				if (!error && solverAnswered(result.first))
+				{
+					winner = _index;
+					for (size_t other = 0; other < m_solvers.size(); ++other)
+						if (other != _index && !states[other].finished)
+						{
+							states[other].cancelled = true;
+							m_solvers[other]->interrupt();
+						}
+				}
+				results[_index] = move(result);
+				errors[_index] = error;
 			}
 		}
-		else if (result == CheckResult::UNKNOWN && lastResult == CheckResult::ERROR)
-			lastResult = result;
+
+		lock_guard<mutex> lock(resultMutex);
+		states[_index].finished = true;
+		solverFinished.notify_all();
+	};
+
+	vector<thread> threads;
+	for (size_t index = 1; index < m_solvers.size(); ++index)
+		threads.emplace_back(runSolver, index);
+	smtAssert(dynamic_cast<SMTLib2Interface*>(m_solvers.front().get()), "");
+	runSolver(0);
+
+	{
+		unique_lock<mutex> lock(resultMutex);
+		auto allFinished = [&]() {
+			for (SolverState const& state: states)
+				if (!state.finished)
+					return false;
+			return true;
+		};
+		while (!allFinished())
+		{
+			for (size_t index = 0; index < m_solvers.size(); ++index)
+				if (states[index].cancelled && !states[index].finished)
+					m_solvers[index]->interrupt();
+			solverFinished.wait_for(lock, chrono::milliseconds(10));
+		}
 	}
-	return make_pair(lastResult, finalValues);
+	for (thread& solverThread: threads)
+		solverThread.join();
+
+	for (exception_ptr const& error: errors)
+		if (error)
+			rethrow_exception(error);
+
+	if (winner)
+		return move(results[*winner]);
+	for (auto const& [result, values]: results)
+		if (result == CheckResult::UNKNOWN)
+			return {CheckResult::UNKNOWN, {}};
+	return {CheckResult::ERROR, {}};
 }
 
 vector<string> SMTPortfolio::unhandledQueries()
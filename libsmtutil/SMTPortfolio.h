@@ -25,16 +25,24 @@
 
 #include <boost/noncopyable.hpp>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace solidity::smtutil
 {
 
+class QueryCache;
+class SMTLib2Interface;
+
 /**
  * The SMTPortfolio wraps all available solvers within a single interface,
  * propagating the functionalities to all solvers.
- * It also checks whether different solvers give conflicting answers
- * to SMT queries.
+ * By default, the solvers are queried one after another and the portfolio checks
+ * whether different solvers give conflicting answers to SMT queries.
+ * In race mode, queries are sent to all solvers concurrently and the first
+ * solver that answers determines the result.
+ * If a query cache is given and at least one in-process solver is available,
+ * the answers of the solvers are stored in and reused from the cache.
  */
 class SMTPortfolio: public SolverInterface, public boost::noncopyable
 {
@@ -43,7 +51,9 @@ public:
 		std::map<util::h256, std::string> _smtlib2Responses = {},
 		frontend::ReadCallback::Callback _smtCallback = {},
 		SMTSolverChoice _enabledSolvers = SMTSolverChoice::All(),
-		std::optional<unsigned> _queryTimeout = {}
+		std::optional<unsigned> _queryTimeout = {},
+		bool _race = false,
+		std::shared_ptr<QueryCache> _queryCache = {}
 	);
 
 	void reset() override;
@@ -62,7 +72,24 @@ public:
 private:
 	static bool solverAnswered(CheckResult result);
 
+	/// Queries all solvers and reports conflicting answers.
+	std::pair<CheckResult, std::vector<std::string>> crossCheck(std::vector<Expression> const& _expressionsToEvaluate);
+	/// Merges the result of a single solver into the result @a _result of the solvers
+	/// queried before, as described at crossCheck.
+	static void mergeResult(
+		std::pair<CheckResult, std::vector<std::string>>& _result,
+		std::pair<CheckResult, std::vector<std::string>> _solverResult
+	);
+	/// Queries all solvers concurrently and returns the first answer.
+	std::pair<CheckResult, std::vector<std::string>> race(std::vector<Expression> const& _expressionsToEvaluate);
+
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
+	/// The first element of m_solvers, used to compute the text of the queries for m_queryCache.
+	SMTLib2Interface* m_smtlib2 = nullptr;
+	bool m_race = false;
+	std::shared_ptr<QueryCache> m_queryCache;
+	/// Names and versions of the solvers in m_solvers, part of the keys in m_queryCache.
+	std::string m_solverNames;
 
 	std::vector<Expression> m_assertions;
 };
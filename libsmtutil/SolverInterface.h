@@ -54,6 +54,42 @@ enum class CheckResult
 	SATISFIABLE, UNSATISFIABLE, UNKNOWN, CONFLICTING, ERROR
 };
 
+class Expression;
+
+/**
+ * Immutable list of the arguments of an Expression.
+ * Copies share the list, so that copying an expression takes constant time
+ * instead of copying all of its subexpressions, and expressions built from
+ * other expressions share their subexpressions.
+ */
+class ExpressionArguments
+{
+public:
+	using const_iterator = std::vector<Expression>::const_iterator;
+
+	ExpressionArguments() = default;
+	ExpressionArguments(std::vector<Expression> _arguments);
+
+	bool empty() const { return !m_arguments; }
+	size_t size() const;
+	Expression const& operator[](size_t _index) const;
+	Expression const& at(size_t _index) const;
+	Expression const& front() const;
+	Expression const& back() const;
+	const_iterator begin() const;
+	const_iterator end() const;
+	operator std::vector<Expression> const&() const;
+
+	/// @returns the list, which is shared by all copies of an expression,
+	/// or nullptr if there are no arguments.
+	std::shared_ptr<std::vector<Expression> const> const& shared() const { return m_arguments; }
+
+private:
+	std::vector<Expression> const& list() const;
+
+	std::shared_ptr<std::vector<Expression> const> m_arguments;
+};
+
 /// C++ representation of an SMTLIB2 expression.
 class Expression
 {
@@ -354,7 +390,7 @@ public:
 	}
 
 	std::string name;
-	std::vector<Expression> arguments;
+	ExpressionArguments arguments;
 	SortPointer sort;
 
 private:
@@ -370,6 +406,26 @@ private:
 		Expression(std::move(_name), std::vector<Expression>{std::move(_arg1), std::move(_arg2)}, _kind) {}
 };
 
+inline ExpressionArguments::ExpressionArguments(std::vector<Expression> _arguments):
+	m_arguments(_arguments.empty() ? nullptr : std::make_shared<std::vector<Expression> const>(std::move(_arguments)))
+{
+}
+
+inline std::vector<Expression> const& ExpressionArguments::list() const
+{
+	static std::vector<Expression> const noArguments;
+	return m_arguments ? *m_arguments : noArguments;
+}
+
+inline size_t ExpressionArguments::size() const { return list().size(); }
+inline Expression const& ExpressionArguments::operator[](size_t _index) const { return list()[_index]; }
+inline Expression const& ExpressionArguments::at(size_t _index) const { return list().at(_index); }
+inline Expression const& ExpressionArguments::front() const { return list().front(); }
+inline Expression const& ExpressionArguments::back() const { return list().back(); }
+inline ExpressionArguments::const_iterator ExpressionArguments::begin() const { return list().begin(); }
+inline ExpressionArguments::const_iterator ExpressionArguments::end() const { return list().end(); }
+inline ExpressionArguments::operator std::vector<Expression> const&() const { return list(); }
+
 DEV_SIMPLE_EXCEPTION(SolverError);
 
 class SolverInterface
@@ -399,6 +455,10 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Asks a call to check() that is running in another thread to stop as soon as possible,
+	/// in which case it returns UNKNOWN or ERROR. Has no effect if no check is running.
+	virtual void interrupt() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
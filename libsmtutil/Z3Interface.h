@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <libsmtutil/ExpressionCache.h>
 #include <libsmtutil/SolverInterface.h>
 #include <boost/noncopyable.hpp>
 #include <z3++.h>
@@ -31,6 +32,8 @@ public:
 	Z3Interface(std::optional<unsigned> _queryTimeout = {});
 
 	static bool available();
+	/// @returns the version of the Z3 library in use.
+	static std::string version();
 
 	void reset() override;
 
@@ -41,6 +44,7 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
 
 	z3::expr toZ3Expr(Expression const& _expr);
 	smtutil::Expression fromZ3Expr(z3::expr const& _expr);
@@ -55,6 +59,8 @@ public:
 	static int const resourceLimit = 1000000;
 
 private:
+	/// Translates @a _expr without using m_translations for @a _expr itself.
+	z3::expr translate(Expression const& _expr);
 	void declareFunction(std::string const& _name, Sort const& _sort);
 
 	z3::sort z3Sort(Sort const& _sort);
@@ -67,6 +73,8 @@ private:
 
 	std::map<std::string, z3::expr> m_constants;
 	std::map<std::string, z3::func_decl> m_functions;
+	/// Translations of the expressions that have arguments. Invalidated when a name is declared again.
+	ExpressionCache<z3::expr> m_translations;
 };
 
 }
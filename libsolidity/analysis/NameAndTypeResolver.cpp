@@ -224,10 +224,13 @@ void NameAndTypeResolver::warnVariablesNamedLikeInstructions() const
 	}
 }
 
-void NameAndTypeResolver::warnHomonymDeclarations() const
+void NameAndTypeResolver::warnHomonymDeclarations(vector<SourceUnit const*> const& _sourceUnits) const
 {
+	// The global scope does not contain homonyms itself, but it can also contain the scopes
+	// of source units that were analysed before.
 	DeclarationContainer::Homonyms homonyms;
-	m_scopes.at(nullptr)->populateHomonyms(back_inserter(homonyms));
+	for (SourceUnit const* sourceUnit: _sourceUnits)
+		m_scopes.at(sourceUnit)->populateHomonyms(back_inserter(homonyms));
 
 	for (auto [innerLocation, outerDeclarations]: homonyms)
 	{
@@ -96,7 +96,8 @@ public:
 	void warnVariablesNamedLikeInstructions() const;
 
 	/// Generate and store warnings about declarations with the same name.
-	void warnHomonymDeclarations() const;
+	/// Only declarations located in one of @a _sourceUnits are considered.
+	void warnHomonymDeclarations(std::vector<SourceUnit const*> const& _sourceUnits) const;
 
 	/// @returns a list of similar identifiers in the current and enclosing scopes. May return empty string if no suggestions.
 	std::string similarNameSuggestions(ASTString const& _name) const;
@@ -42,13 +42,29 @@ public:
 		m_context(_evmVersion, _revertStrings, &m_runtimeContext)
 	{ }
 
-	/// Compiles a contract.
+	/// Compiles a contract, i.e. generates its code and runs the optimiser on it.
 	/// @arg _metadata contains the to be injected metadata CBOR
 	void compileContract(
 		ContractDefinition const& _contract,
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers,
 		bytes const& _metadata
+	)
+	{
+		generateCode(_contract, _otherCompilers, _metadata);
+		optimise();
+	}
+	/// Generates the creation and runtime assembly of a contract without optimising it.
+	/// @arg _metadata contains the to be injected metadata CBOR
+	void generateCode(
+		ContractDefinition const& _contract,
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers,
+		bytes const& _metadata
 	);
+	/// Runs the optimiser on the assembly generated by @a generateCode.
+	/// Only accesses the assemblies reachable from the creation assembly, in particular
+	/// it does not access the AST or any type information.
+	/// Sub-assemblies are optimised on up to @a _threadCount threads.
+	void optimise(size_t _threadCount = 1) { m_context.optimise(m_optimiserSettings, _threadCount); }
 	/// @returns Entire assembly.
 	evmasm::Assembly const& assembly() const { return m_context.assembly(); }
 	/// @returns Runtime assembly.
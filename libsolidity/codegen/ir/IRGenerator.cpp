@@ -31,6 +31,8 @@
 #include <libsolidity/codegen/CompilerUtils.h>
 
 #include <libyul/AssemblyStack.h>
+#include <libyul/Object.h>
+#include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/Utilities.h>
 
 #include <libsolutil/CommonData.h>
@@ -48,7 +50,23 @@ using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
 
-pair<string, string> IRGenerator::run(
+namespace
+{
+
+string irWarning()
+{
+	return
+		"/*******************************************************\n"
+		" *                       WARNING                       *\n"
+		" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
+		" *       It can result in LOSS OF FUNDS or worse       *\n"
+		" *                !USE AT YOUR OWN RISK!               *\n"
+		" *******************************************************/\n\n";
+}
+
+}
+
+pair<string, shared_ptr<yul::Object>> IRGenerator::run(
 	ContractDefinition const& _contract,
 	map<ContractDefinition const*, string_view const> const& _otherYulSources
 )
@@ -63,17 +81,21 @@ pair<string, string> IRGenerator::run(
 			errorMessage += langutil::SourceReferenceFormatter::formatErrorInformation(*error);
 		solAssert(false, ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
 	}
+	asmStack.setThreadCount(m_threadCount);
+	asmStack.enableOptimiserProfile(m_profileOptimiser);
 	asmStack.optimize();
+	if (m_profileOptimiser)
+		m_optimiserProfile = asmStack.optimiserProfile();
 
-	string warning =
-		"/*******************************************************\n"
-		" *                       WARNING                       *\n"
-		" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
-		" *       It can result in LOSS OF FUNDS or worse       *\n"
-		" *                !USE AT YOUR OWN RISK!               *\n"
-		" *******************************************************/\n\n";
+	return {irWarning() + ir, asmStack.parserResult()};
+}
 
-	return {warning + ir, warning + asmStack.print()};
+string IRGenerator::print(yul::Object const& _object) const
+{
+	return
+		irWarning() +
+		_object.toString(&yul::EVMDialect::strictAssemblyForEVMObjects(m_evmVersion)) +
+		"\n";
 }
 
 string IRGenerator::generate(
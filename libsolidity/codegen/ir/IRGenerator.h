@@ -28,8 +28,15 @@
 #include <libsolidity/codegen/ir/IRGenerationContext.h>
 #include <libsolidity/codegen/YulUtilFunctions.h>
 #include <liblangutil/EVMVersion.h>
+#include <json/json.h>
+#include <memory>
 #include <string>
 
+namespace solidity::yul
+{
+struct Object;
+}
+
 namespace solidity::frontend
 {
 
@@ -41,20 +48,29 @@ public:
 	IRGenerator(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		OptimiserSettings _optimiserSettings
+		OptimiserSettings _optimiserSettings,
+		size_t _threadCount,
+		bool _profileOptimiser
 	):
 		m_evmVersion(_evmVersion),
 		m_optimiserSettings(_optimiserSettings),
+		m_threadCount(_threadCount),
+		m_profileOptimiser(_profileOptimiser),
 		m_context(_evmVersion, _revertStrings, std::move(_optimiserSettings)),
 		m_utils(_evmVersion, m_context.revertStrings(), m_context.functionCollector())
 	{}
 
-	/// Generates and returns the IR code, in unoptimized and optimized form
-	/// (or just pretty-printed, depending on the optimizer settings).
-	std::pair<std::string, std::string> run(
+	/// Generates the IR code and parses it.
+	/// @returns the unoptimized IR code and the analyzed Yul object, which is optimized
+	/// depending on the optimizer settings.
+	std::pair<std::string, std::shared_ptr<yul::Object>> run(
 		ContractDefinition const& _contract,
 		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
 	);
+	/// @returns the IR code of a Yul object returned by @a run in (pretty-printed) text form.
+	std::string print(yul::Object const& _object) const;
+	/// @returns the optimizer statistics of the last call to @a run, if enabled in the constructor.
+	Json::Value const& optimiserProfile() const { return m_optimiserProfile; }
 
 private:
 	std::string generate(
@@ -114,6 +130,10 @@ private:
 
 	langutil::EVMVersion const m_evmVersion;
 	OptimiserSettings const m_optimiserSettings;
+	/// Maximum number of threads used to optimize the Yul objects concurrently.
+	size_t const m_threadCount;
+	bool const m_profileOptimiser;
+	Json::Value m_optimiserProfile;
 
 	IRGenerationContext m_context;
 	YulUtilFunctions m_utils;
@@ -27,12 +27,59 @@
 #include <z3_version.h>
 #endif
 
+#include <exception>
+#include <thread>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::langutil;
 using namespace solidity::frontend;
 
+namespace
+{
+
+/// Forwards all calls to another solver and records the declared variables,
+/// so that they can be declared in further solvers.
+class DeclarationRecorder: public smtutil::SolverInterface
+{
+public:
+	DeclarationRecorder(
+		unique_ptr<smtutil::SolverInterface> _solver,
+		vector<pair<string, smtutil::SortPointer>>& _declarations
+	):
+		m_solver(move(_solver)),
+		m_declarations(_declarations)
+	{}
+
+	void reset() override
+	{
+		m_declarations.clear();
+		m_solver->reset();
+	}
+	void push() override { m_solver->push(); }
+	void pop() override { m_solver->pop(); }
+	void declareVariable(string const& _name, smtutil::SortPointer const& _sort) override
+	{
+		m_declarations.emplace_back(_name, _sort);
+		m_solver->declareVariable(_name, _sort);
+	}
+	void addAssertion(smtutil::Expression const& _expr) override { m_solver->addAssertion(_expr); }
+	pair<smtutil::CheckResult, vector<string>> check(vector<smtutil::Expression> const& _expressionsToEvaluate) override
+	{
+		return m_solver->check(_expressionsToEvaluate);
+	}
+	void interrupt() override { m_solver->interrupt(); }
+	vector<string> unhandledQueries() override { return m_solver->unhandledQueries(); }
+	size_t solvers() override { return m_solver->solvers(); }
+
+private:
+	unique_ptr<smtutil::SolverInterface> m_solver;
+	vector<pair<string, smtutil::SortPointer>>& m_declarations;
+};
+
+}
+
 BMC::BMC(
 	smt::EncodingContext& _context,
 	ErrorReporter& _errorReporter,
@@ -42,7 +89,19 @@ BMC::BMC(
 	ModelCheckerSettings const& _settings
 ):
 	SMTEncoder(_context),
-	m_interface(make_unique<smtutil::SMTPortfolio>(_smtlib2Responses, _smtCallback, _enabledSolvers, _settings.timeout)),
+	m_interface(make_unique<DeclarationRecorder>(
+		make_unique<smtutil::SMTPortfolio>(
+			_smtlib2Responses,
+			_smtCallback,
+			_enabledSolvers,
+			_settings.timeout,
+			_settings.raceSolvers,
+			_settings.queryCache
+		),
+		m_declarations
+	)),
+	m_smtlib2Responses(_smtlib2Responses),
+	m_enabledSolvers(_enabledSolvers),
 	m_outerErrorReporter(_errorReporter),
 	m_settings(_settings)
 {
@@ -666,8 +725,36 @@ pair<vector<smtutil::Expression>, vector<string>> BMC::modelExpressions()
 
 void BMC::checkVerificationTargets()
 {
+	solAssert(m_queries.empty(), "");
 	for (auto& target: m_verificationTargets)
 		checkVerificationTarget(target);
+	vector<BMCQuery> queries = move(m_queries);
+	m_queries.clear();
+
+	vector<BMCQueryResult> results;
+	// Without Z3 or CVC4, the queries have to go through the SMT callback, which is not thread-safe.
+	if (m_settings.threads > 1 && queries.size() > 1 && m_interface->solvers() > 1)
+		results = checkQueriesConcurrently(queries);
+	else
+		for (BMCQuery const& query: queries)
+			results.emplace_back(checkQuery(query));
+
+	solAssert(results.size() == queries.size(), "");
+	for (size_t i = 0; i < queries.size(); ++i)
+	{
+		if (results[i].solverError)
+			m_errorReporter.warning(8140_error, *results[i].solverError);
+		if (queries[i].constantCondition)
+		{
+			solAssert(i + 1 < queries.size(), "");
+			if (results[i + 1].solverError)
+				m_errorReporter.warning(8140_error, *results[i + 1].solverError);
+			reportConstantCondition(queries[i], results[i].result, results[i + 1].result);
+			++i;
+		}
+		else
+			reportQueryResult(queries[i], results[i].result, results[i].values);
+	}
 }
 
 void BMC::checkVerificationTarget(BMCVerificationTarget& _target)
@@ -855,10 +942,7 @@ void BMC::addVerificationTarget(
 		m_callStack,
 		modelExpressions()
 	};
-	if (_type == VerificationTargetType::ConstantCondition)
-		checkVerificationTarget(target);
-	else
-		m_verificationTargets.emplace_back(move(target));
+	m_verificationTargets.emplace_back(move(target));
 }
 
 /// Solving.
@@ -875,22 +959,91 @@ void BMC::checkCondition(
 	smtutil::Expression const* _additionalValue
 )
 {
-	m_interface->push();
-	m_interface->addAssertion(_condition);
-
-	vector<smtutil::Expression> expressionsToEvaluate;
-	vector<string> expressionNames;
-	tie(expressionsToEvaluate, expressionNames) = _modelExpressions;
+	BMCQuery query{
+		move(_condition),
+		_callStack,
+		_modelExpressions.first,
+		_modelExpressions.second,
+		_location,
+		_errorHappens,
+		_errorMightHappen,
+		_description
+	};
 	if (_callStack.size())
 		if (_additionalValue)
 		{
-			expressionsToEvaluate.emplace_back(*_additionalValue);
-			expressionNames.push_back(_additionalValueName);
+			query.expressionsToEvaluate.emplace_back(*_additionalValue);
+			query.expressionNames.push_back(_additionalValueName);
+		}
+	m_queries.emplace_back(move(query));
+}
+
+BMC::BMCQueryResult BMC::checkQuery(BMCQuery const& _query)
+{
+	m_interface->push();
+	m_interface->addAssertion(_query.condition);
+	BMCQueryResult result = checkSatisfiableAndGenerateModel(*m_interface, _query.expressionsToEvaluate);
+	m_interface->pop();
+	return result;
+}
+
+vector<BMC::BMCQueryResult> BMC::checkQueriesConcurrently(vector<BMCQuery> const& _queries)
+{
+	size_t const solverCount = min(m_settings.threads, _queries.size());
+	vector<BMCQueryResult> results(_queries.size());
+	vector<vector<string>> unhandledQueries(_queries.size());
+	vector<exception_ptr> errors(solverCount);
+
+	auto worker = [&](size_t _solverIndex)
+	{
+		try
+		{
+			// The solvers are queried one after another, so that the results only depend on
+			// the query and each worker uses a single thread.
+			smtutil::SMTPortfolio solver(
+				m_smtlib2Responses,
+				{},
+				m_enabledSolvers,
+				m_settings.timeout,
+				false,
+				m_settings.queryCache
+			);
+			for (auto const& [name, sort]: m_declarations)
+				solver.declareVariable(name, sort);
+			for (size_t i = _solverIndex; i < _queries.size(); i += solverCount)
+			{
+				size_t const handledBefore = solver.unhandledQueries().size();
+				solver.push();
+				solver.addAssertion(_queries[i].condition);
+				results[i] = checkSatisfiableAndGenerateModel(solver, _queries[i].expressionsToEvaluate);
+				solver.pop();
+				vector<string> unhandled = solver.unhandledQueries();
+				unhandledQueries[i].assign(unhandled.begin() + static_cast<ptrdiff_t>(handledBefore), unhandled.end());
+			}
+		}
+		catch (...)
+		{
+			errors[_solverIndex] = current_exception();
 		}
-	smtutil::CheckResult result;
-	vector<string> values;
-	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
+	};
+
+	vector<thread> threads;
+	for (size_t solverIndex = 1; solverIndex < solverCount; ++solverIndex)
+		threads.emplace_back(worker, solverIndex);
+	worker(0);
+	for (thread& workerThread: threads)
+		workerThread.join();
+
+	for (exception_ptr const& error: errors)
+		if (error)
+			rethrow_exception(error);
+	for (vector<string>& unhandled: unhandledQueries)
+		m_unhandledQueries += move(unhandled);
+	return results;
+}
 
+void BMC::reportQueryResult(BMCQuery const& _query, smtutil::CheckResult _result, vector<string> const& _values)
+{
 	string extraComment = SMTEncoder::extraComment();
 	if (m_loopExecutionHappened)
 		extraComment +=
@@ -906,30 +1059,30 @@ void BMC::checkCondition(
 	SecondarySourceLocation secondaryLocation{};
 	secondaryLocation.append(extraComment, SourceLocation{});
 
-	switch (result)
+	switch (_result)
 	{
 	case smtutil::CheckResult::SATISFIABLE:
 	{
-		solAssert(!_callStack.empty(), "");
+		solAssert(!_query.callStack.empty(), "");
 		std::ostringstream message;
-		message << "BMC: " << _description << " happens here.";
+		message << "BMC: " << _query.description << " happens here.";
 		std::ostringstream modelMessage;
 		modelMessage << "Counterexample:\n";
-		solAssert(values.size() == expressionNames.size(), "");
+		solAssert(_values.size() == _query.expressionNames.size(), "");
 		map<string, string> sortedModel;
-		for (size_t i = 0; i < values.size(); ++i)
-			if (expressionsToEvaluate.at(i).name != values.at(i))
-				sortedModel[expressionNames.at(i)] = values.at(i);
+		for (size_t i = 0; i < _values.size(); ++i)
+			if (_query.expressionsToEvaluate.at(i).name != _values.at(i))
+				sortedModel[_query.expressionNames.at(i)] = _values.at(i);
 
 		for (auto const& eval: sortedModel)
 			modelMessage << "  " << eval.first << " = " << eval.second << "\n";
 
 		m_errorReporter.warning(
-			_errorHappens,
-			_location,
+			_query.errorHappens,
+			_query.location,
 			message.str(),
 			SecondarySourceLocation().append(modelMessage.str(), SourceLocation{})
-			.append(SMTEncoder::callStackMessage(_callStack))
+			.append(SMTEncoder::callStackMessage(_query.callStack))
 			.append(move(secondaryLocation))
 		);
 		break;
@@ -937,17 +1090,15 @@ void BMC::checkCondition(
 	case smtutil::CheckResult::UNSATISFIABLE:
 		break;
 	case smtutil::CheckResult::UNKNOWN:
-		m_errorReporter.warning(_errorMightHappen, _location, "BMC: " + _description + " might happen here.", secondaryLocation);
+		m_errorReporter.warning(_query.errorMightHappen, _query.location, "BMC: " + _query.description + " might happen here.", secondaryLocation);
 		break;
 	case smtutil::CheckResult::CONFLICTING:
-		m_errorReporter.warning(1584_error, _location, "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
+		m_errorReporter.warning(1584_error, _query.location, "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
 		break;
 	case smtutil::CheckResult::ERROR:
-		m_errorReporter.warning(1823_error, _location, "BMC: Error trying to invoke SMT solver.");
+		m_errorReporter.warning(1823_error, _query.location, "BMC: Error trying to invoke SMT solver.");
 		break;
 	}
-
-	m_interface->pop();
 }
 
 void BMC::checkBooleanNotConstant(
@@ -961,72 +1112,87 @@ void BMC::checkBooleanNotConstant(
 	if (dynamic_cast<Literal const*>(&_condition))
 		return;
 
-	m_interface->push();
-	m_interface->addAssertion(_constraints && _value);
-	auto positiveResult = checkSatisfiable();
-	m_interface->pop();
-
-	m_interface->push();
-	m_interface->addAssertion(_constraints && !_value);
-	auto negatedResult = checkSatisfiable();
-	m_interface->pop();
+	BMCQuery positiveQuery{
+		_constraints && _value,
+		_callStack,
+		{},
+		{},
+		_condition.location(),
+		{},
+		{},
+		"",
+		true
+	};
+	BMCQuery negatedQuery = positiveQuery;
+	negatedQuery.condition = _constraints && !_value;
+	negatedQuery.constantCondition = false;
+	m_queries.emplace_back(move(positiveQuery));
+	m_queries.emplace_back(move(negatedQuery));
+}
 
-	if (positiveResult == smtutil::CheckResult::ERROR || negatedResult == smtutil::CheckResult::ERROR)
-		m_errorReporter.warning(8592_error, _condition.location(), "BMC: Error trying to invoke SMT solver.");
-	else if (positiveResult == smtutil::CheckResult::CONFLICTING || negatedResult == smtutil::CheckResult::CONFLICTING)
-		m_errorReporter.warning(3356_error, _condition.location(), "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
-	else if (positiveResult == smtutil::CheckResult::SATISFIABLE && negatedResult == smtutil::CheckResult::SATISFIABLE)
+void BMC::reportConstantCondition(
+	BMCQuery const& _query,
+	smtutil::CheckResult _positiveResult,
+	smtutil::CheckResult _negatedResult
+)
+{
+	if (_positiveResult == smtutil::CheckResult::ERROR || _negatedResult == smtutil::CheckResult::ERROR)
+		m_errorReporter.warning(8592_error, _query.location, "BMC: Error trying to invoke SMT solver.");
+	else if (_positiveResult == smtutil::CheckResult::CONFLICTING || _negatedResult == smtutil::CheckResult::CONFLICTING)
+		m_errorReporter.warning(3356_error, _query.location, "BMC: At least two SMT solvers provided conflicting answers. Results might not be sound.");
+	else if (_positiveResult == smtutil::CheckResult::SATISFIABLE && _negatedResult == smtutil::CheckResult::SATISFIABLE)
 	{
 		// everything fine.
 	}
-	else if (positiveResult == smtutil::CheckResult::UNKNOWN || negatedResult == smtutil::CheckResult::UNKNOWN)
+	else if (_positiveResult == smtutil::CheckResult::UNKNOWN || _negatedResult == smtutil::CheckResult::UNKNOWN)
 	{
 		// can't do anything.
 	}
-	else if (positiveResult == smtutil::CheckResult::UNSATISFIABLE && negatedResult == smtutil::CheckResult::UNSATISFIABLE)
-		m_errorReporter.warning(2512_error, _condition.location(), "BMC: Condition unreachable.", SMTEncoder::callStackMessage(_callStack));
+	else if (_positiveResult == smtutil::CheckResult::UNSATISFIABLE && _negatedResult == smtutil::CheckResult::UNSATISFIABLE)
+		m_errorReporter.warning(2512_error, _query.location, "BMC: Condition unreachable.", SMTEncoder::callStackMessage(_query.callStack));
 	else
 	{
 		string description;
-		if (positiveResult == smtutil::CheckResult::SATISFIABLE)
+		if (_positiveResult == smtutil::CheckResult::SATISFIABLE)
 		{
-			solAssert(negatedResult == smtutil::CheckResult::UNSATISFIABLE, "");
+			solAssert(_negatedResult == smtutil::CheckResult::UNSATISFIABLE, "");
 			description = "BMC: Condition is always true.";
 		}
 		else
 		{
-			solAssert(positiveResult == smtutil::CheckResult::UNSATISFIABLE, "");
-			solAssert(negatedResult == smtutil::CheckResult::SATISFIABLE, "");
+			solAssert(_positiveResult == smtutil::CheckResult::UNSATISFIABLE, "");
+			solAssert(_negatedResult == smtutil::CheckResult::SATISFIABLE, "");
 			description = "BMC: Condition is always false.";
 		}
 		m_errorReporter.warning(
 			6838_error,
-			_condition.location(),
+			_query.location,
 			description,
-			SMTEncoder::callStackMessage(_callStack)
+			SMTEncoder::callStackMessage(_query.callStack)
 		);
 	}
 }
 
-pair<smtutil::CheckResult, vector<string>>
-BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expressionsToEvaluate)
+BMC::BMCQueryResult BMC::checkSatisfiableAndGenerateModel(
+	smtutil::SolverInterface& _solver,
+	vector<smtutil::Expression> const& _expressionsToEvaluate
+)
 {
-	smtutil::CheckResult result;
-	vector<string> values;
+	BMCQueryResult result;
 	try
 	{
-		tie(result, values) = m_interface->check(_expressionsToEvaluate);
+		tie(result.result, result.values) = _solver.check(_expressionsToEvaluate);
 	}
 	catch (smtutil::SolverError const& _e)
 	{
 		string description("BMC: Error querying SMT solver");
 		if (_e.comment())
 			description += ": " + *_e.comment();
-		m_errorReporter.warning(8140_error, description);
-		result = smtutil::CheckResult::ERROR;
+		result.solverError = move(description);
+		result.result = smtutil::CheckResult::ERROR;
 	}
 
-	for (string& value: values)
+	for (string& value: result.values)
 	{
 		try
 		{
@@ -1036,12 +1202,7 @@ BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expres
 		catch (...) { }
 	}
 
-	return make_pair(result, values);
-}
-
-smtutil::CheckResult BMC::checkSatisfiable()
-{
-	return checkSatisfiableAndGenerateModel({}).first;
+	return result;
 }
 
 void BMC::assignment(smt::SymbolicVariable& _symVar, smtutil::Expression const& _value)
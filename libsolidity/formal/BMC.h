@@ -38,6 +38,9 @@
 #include <libsmtutil/SolverInterface.h>
 #include <liblangutil/ErrorReporter.h>
 
+#include <libsolutil/CommonData.h>
+
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -71,7 +74,7 @@ public:
 	/// This is used if the SMT solver is not directly linked into this binary.
 	/// @returns a list of inputs to the SMT solver that were not part of the argument to
 	/// the constructor.
-	std::vector<std::string> unhandledQueries() { return m_interface->unhandledQueries(); }
+	std::vector<std::string> unhandledQueries() { return m_interface->unhandledQueries() + m_unhandledQueries; }
 
 	/// @returns true if _funCall should be inlined, otherwise false.
 	/// @param _scopeContract The contract that contains the current function being analyzed.
@@ -154,7 +157,31 @@ private:
 
 	/// Solver related.
 	//@{
-	/// Check that a condition can be satisfied.
+	/// Query whether a condition can be satisfied, together with what is needed to report the result.
+	struct BMCQuery
+	{
+		smtutil::Expression condition;
+		std::vector<CallStackEntry> callStack;
+		std::vector<smtutil::Expression> expressionsToEvaluate;
+		std::vector<std::string> expressionNames;
+		langutil::SourceLocation location;
+		langutil::ErrorId errorHappens;
+		langutil::ErrorId errorMightHappen;
+		std::string description;
+		/// Whether this query and the next one check whether a condition is constant.
+		/// This query checks the condition itself and the next one its negation.
+		bool constantCondition = false;
+	};
+	/// Result of a BMCQuery. If the solver threw an error, @a solverError contains its description.
+	struct BMCQueryResult
+	{
+		smtutil::CheckResult result = smtutil::CheckResult::ERROR;
+		std::vector<std::string> values;
+		std::optional<std::string> solverError;
+	};
+
+	/// Adds a query whether the condition can be satisfied to m_queries.
+	/// The queries are checked and reported at the end of checkVerificationTargets.
 	void checkCondition(
 		smtutil::Expression _condition,
 		std::vector<CallStackEntry> const& _callStack,
@@ -166,21 +193,47 @@ private:
 		std::string const& _additionalValueName = "",
 		smtutil::Expression const* _additionalValue = nullptr
 	);
-	/// Checks that a boolean condition is not constant. Do not warn if the expression
-	/// is a literal constant.
+	/// Adds the queries whether a boolean condition can be true and whether it can be false
+	/// to m_queries. Do not warn if the expression is a literal constant.
 	void checkBooleanNotConstant(
 		Expression const& _condition,
 		smtutil::Expression const& _constraints,
 		smtutil::Expression const& _value,
 		std::vector<CallStackEntry> const& _callStack
 	);
-	std::pair<smtutil::CheckResult, std::vector<std::string>>
-	checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _expressionsToEvaluate);
+	/// Checks @a _query using m_interface.
+	BMCQueryResult checkQuery(BMCQuery const& _query);
+	/// Checks the queries using m_settings.threads solvers of their own, which are set up
+	/// with the declarations in m_declarations. Query i is checked by solver i modulo the
+	/// number of solvers, so that the results do not depend on the scheduling of the threads.
+	std::vector<BMCQueryResult> checkQueriesConcurrently(std::vector<BMCQuery> const& _queries);
+	void reportQueryResult(BMCQuery const& _query, smtutil::CheckResult _result, std::vector<std::string> const& _values);
+	/// Reports whether the condition of the constant condition query @a _query is constant,
+	/// given the results of the query and of its negation.
+	void reportConstantCondition(
+		BMCQuery const& _query,
+		smtutil::CheckResult _positiveResult,
+		smtutil::CheckResult _negatedResult
+	);
 
-	smtutil::CheckResult checkSatisfiable();
+	/// Checks the satisfiability of the assertions in @a _solver and evaluates the expressions if
+	/// a model is available. Solver errors are returned in the result instead of being reported.
+	static BMCQueryResult checkSatisfiableAndGenerateModel(
+		smtutil::SolverInterface& _solver,
+		std::vector<smtutil::Expression> const& _expressionsToEvaluate
+	);
 	//@}
 
+	/// Variables declared in m_interface, in the order of their declaration.
+	std::vector<std::pair<std::string, smtutil::SortPointer>> m_declarations;
 	std::unique_ptr<smtutil::SolverInterface> m_interface;
+	/// Arguments used to create the solvers for checking queries concurrently.
+	std::map<h256, std::string> m_smtlib2Responses;
+	smtutil::SMTSolverChoice m_enabledSolvers;
+	/// Queries of the verification targets that are currently being checked.
+	std::vector<BMCQuery> m_queries;
+	/// Queries that solvers created by checkQueriesConcurrently were not able to respond to.
+	std::vector<std::string> m_unhandledQueries;
 
 	/// Flags used for better warning messages.
 	bool m_loopExecutionHappened = false;
@@ -28,10 +28,12 @@
 #include <libsolidity/formal/SymbolicTypes.h>
 
 #include <libsolidity/ast/TypeProvider.h>
+#include <libsolidity/interface/Version.h>
 
 #include <libsmtutil/CHCSmtLib2Interface.h>
 #include <libsolutil/Algorithms.h>
 
+#include <boost/algorithm/string/split.hpp>
 #include <boost/range/adaptor/reversed.hpp>
 
 #ifdef HAVE_Z3_DLOPEN
@@ -518,7 +520,10 @@ void CHC::endVisit(IndexRangeAccess const& _range)
 	if (!sliceData.first)
 	{
 		for (auto pred: sliceData.second.predicates)
+		{
 			m_interface->registerRelation(pred->functor());
+			m_relations.insert(pred->functor().name);
+		}
 		for (auto const& rule: sliceData.second.rules)
 			addRule(rule, "");
 	}
@@ -843,6 +848,10 @@ void CHC::resetSourceAnalysis()
 	Predicate::reset();
 	ArraySlicePredicate::reset();
 	m_blockCounter = 0;
+	m_rules.clear();
+	m_rulesByHead.clear();
+	m_relations.clear();
+	m_canonicalCones.clear();
 
 	bool usesZ3 = false;
 #ifdef HAVE_Z3
@@ -863,6 +872,8 @@ void CHC::resetSourceAnalysis()
 		solAssert(smtlib2Interface, "");
 		m_context.setSolver(smtlib2Interface->smtlib2Interface());
 	}
+	// The SMT-LIB2 interface gets its answers from the caller, who can cache them.
+	m_useQueryCache = usesZ3 && m_settings.queryCache;
 
 	m_context.clear();
 	m_context.resetUniqueId();
@@ -941,6 +952,7 @@ Predicate const* CHC::createSymbolicBlock(SortPointer _sort, string const& _name
 {
 	auto const* block = Predicate::create(_sort, _name, _predType, m_context, _node, _contractContext);
 	m_interface->registerRelation(block->functor());
+	m_relations.insert(block->functor().name);
 	return block;
 }
 
@@ -1290,6 +1302,25 @@ smtutil::Expression CHC::predicate(FunctionCall const& _funCall)
 void CHC::addRule(smtutil::Expression const& _rule, string const& _ruleName)
 {
 	m_interface->addRule(_rule, _ruleName);
+
+	if (!m_useQueryCache)
+		return;
+	HornRule rule{_rule, _rule.name, {}};
+	if (_rule.name == "implies")
+	{
+		solAssert(_rule.arguments.size() == 2, "");
+		rule.head = _rule.arguments.at(1).name;
+		set<string> seen;
+		auto collect = [&](smtutil::Expression const& _expr, auto&& _collect) -> void {
+			if (m_relations.count(_expr.name) && seen.insert(_expr.name).second)
+				rule.body.push_back(_expr.name);
+			for (auto const& argument: _expr.arguments)
+				_collect(argument, _collect);
+		};
+		collect(_rule.arguments.at(0), collect);
+	}
+	m_rulesByHead[rule.head].push_back(m_rules.size());
+	m_rules.emplace_back(move(rule));
 }
 
 pair<CheckResult, CHCSolverInterface::CexGraph> CHC::query(smtutil::Expression const& _query, langutil::SourceLocation const& _location)
@@ -1477,14 +1508,43 @@ void CHC::checkAndReportTarget(
 	createErrorBlock();
 	connectBlocks(_target.value, error(), _target.constraints);
 	auto const& location = _target.errorNode->location();
-	auto const& [result, model] = query(error(), location);
+
+	CheckResult result;
+	optional<string> cex;
+	optional<h256> cacheKey;
+	optional<QueryCache::Entry> cached;
+	if (m_useQueryCache)
+	{
+		cacheKey = queryCacheKey();
+		cached = m_settings.queryCache->load(*cacheKey);
+	}
+	if (cached)
+	{
+		result = cached->first;
+		if (!cached->second.empty())
+			cex = boost::algorithm::join(cached->second, "\n");
+	}
+	else
+	{
+		CHCSolverInterface::CexGraph model;
+		tie(result, model) = query(error(), location);
+		if (result == CheckResult::SATISFIABLE)
+			cex = generateCounterexample(model, error().name);
+		if (cacheKey)
+		{
+			vector<string> lines;
+			if (cex)
+				boost::split(lines, *cex, [](char _c) { return _c == '\n'; });
+			m_settings.queryCache->store(*cacheKey, result, lines);
+		}
+	}
+
 	if (result == CheckResult::UNSATISFIABLE)
 		m_safeTargets[_target.errorNode].insert(_target.type);
 	else if (result == CheckResult::SATISFIABLE)
 	{
 		solAssert(!_satMsg.empty(), "");
 		m_unsafeTargets[_target.errorNode].insert(_target.type);
-		auto cex = generateCounterexample(model, error().name);
 		if (cex)
 			m_errorReporter.warning(
 				_errorReporterId,
@@ -1674,6 +1734,96 @@ string CHC::cex2dot(CHCSolverInterface::CexGraph const& _cex)
 	return dot;
 }
 
+h256 CHC::queryCacheKey()
+{
+	// Only the rules whose heads the error predicate transitively depends on
+	// can change the result of the query.
+	vector<string> errorBody;
+	for (size_t index: m_rulesByHead.at(error().name))
+		for (auto const& relation: m_rules.at(index).body)
+			if (find(errorBody.begin(), errorBody.end(), relation) == errorBody.end())
+				errorBody.push_back(relation);
+
+	if (!m_canonicalCones.count(errorBody))
+	{
+		set<size_t> cone;
+		BreadthFirstSearch<string>{{errorBody.begin(), errorBody.end()}}.run([&](string const& _relation, auto&& _addChild) {
+			if (m_rulesByHead.count(_relation))
+				for (size_t index: m_rulesByHead.at(_relation))
+				{
+					cone.insert(index);
+					for (auto const& relation: m_rules.at(index).body)
+						_addChild(relation);
+				}
+		});
+
+		// The rules are printed in the order in which they were created, which only
+		// depends on the code they encode. The numbering of the names follows that order.
+		smt::CanonicalHornPrinter printer;
+		string text;
+		vector<string> relations;
+		auto addRelation = [&](string const& _relation) {
+			if (find(relations.begin(), relations.end(), _relation) == relations.end())
+				relations.push_back(_relation);
+		};
+		for (auto const& relation: errorBody)
+			addRelation(relation);
+		for (size_t index: cone)
+		{
+			addRelation(m_rules.at(index).head);
+			for (auto const& relation: m_rules.at(index).body)
+				addRelation(relation);
+			text += printer.print(m_rules.at(index).rule) + "\n";
+		}
+		// Predicates without rules are empty, unlike uninterpreted functions of the same sort.
+		for (auto const& relation: relations)
+		{
+			Predicate const* predicate = Predicate::predicate(relation);
+			text += "(relation " + printer.print(predicate->functor()) + ")" + counterexampleNames(*predicate) + "\n";
+		}
+		m_canonicalCones.emplace(errorBody, make_pair(move(printer), move(text)));
+	}
+
+	auto [printer, text] = m_canonicalCones.at(errorBody);
+	for (size_t index: m_rulesByHead.at(error().name))
+		text += printer.print(m_rules.at(index).rule) + "\n";
+	text += "(query " + printer.print(error()) + ")\n";
+	// Only answers are stored, which do not depend on the timeout.
+	string solver = "chc " + VersionString;
+#ifdef HAVE_Z3
+	// The cache is only used with Z3, see m_useQueryCache.
+	solver += " z3 " + Z3Interface::version();
+#endif
+	return QueryCache::key(solver, text);
+}
+
+string CHC::counterexampleNames(Predicate const& _predicate) const
+{
+	auto variables = [](auto const& _variables) {
+		string result;
+		for (auto const& variable: _variables)
+			if (variable)
+				result += " " + variable->name() + ":" + variable->type()->toString(true);
+		return result;
+	};
+
+	string names;
+	if (auto const* call = _predicate.programFunctionCall())
+		names += " call " + call->location().text();
+	if (auto const* contract = _predicate.programContract())
+		names += " contract " + contract->name();
+	if (auto const* function = _predicate.programFunction())
+	{
+		if (auto const* contract = function->annotation().contract)
+			names += " contract " + contract->name();
+		names += " " + string(TokenTraits::toString(function->kind())) + " " + function->name();
+		names += variables(function->parameters()) + " returns" + variables(function->returnParameters());
+	}
+	if (auto stateVariables = _predicate.stateVariables())
+		names += " state" + variables(*stateVariables);
+	return names;
+}
+
 string CHC::uniquePrefix()
 {
 	return to_string(m_blockCounter++);
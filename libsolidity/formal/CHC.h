@@ -31,6 +31,7 @@
 
 #pragma once
 
+#include <libsolidity/formal/CanonicalHornPrinter.h>
 #include <libsolidity/formal/ModelCheckerSettings.h>
 #include <libsolidity/formal/Predicate.h>
 #include <libsolidity/formal/SMTEncoder.h>
@@ -245,6 +246,19 @@ private:
 	std::string cex2dot(smtutil::CHCSolverInterface::CexGraph const& _graph);
 	//@}
 
+	/// Incremental verification.
+	//@{
+	/// @returns the key under which the result of the query for the current
+	/// error predicate is stored in the query cache.
+	/// The key covers the canonical form of the rules the error predicate
+	/// depends on, the program elements a counterexample refers to and the
+	/// versions of the compiler and Z3, so it does not change if unrelated code changes.
+	util::h256 queryCacheKey();
+	/// @returns the names and types of the program elements that
+	/// a counterexample that goes through @a _predicate prints.
+	std::string counterexampleNames(Predicate const& _predicate) const;
+	//@}
+
 	/// Misc.
 	//@{
 	/// @returns a prefix to be used in a new unique block name
@@ -360,6 +374,31 @@ private:
 	std::vector<Predicate const*> m_returnDests;
 	//@}
 
+	/// Incremental verification.
+	//@{
+	/// Whether the results of queries are loaded from and stored in m_settings.queryCache.
+	bool m_useQueryCache = false;
+
+	struct HornRule
+	{
+		smtutil::Expression rule;
+		std::string head;
+		/// The predicates in the body of the rule in the order of their first appearance.
+		std::vector<std::string> body;
+	};
+	/// All rules given to the solver in the current source analysis.
+	/// Only recorded if m_useQueryCache is set.
+	std::vector<HornRule> m_rules;
+	/// Indices of m_rules by the name of the head predicate.
+	std::map<std::string, std::vector<size_t>> m_rulesByHead;
+	/// Names of the registered predicates.
+	std::set<std::string> m_relations;
+	/// Canonical form of the rules the body predicates of an error rule depend on,
+	/// by the names of these body predicates, together with the printer that
+	/// produced them and the counterexample names of all predicates involved.
+	std::map<std::vector<std::string>, std::pair<smt::CanonicalHornPrinter, std::string>> m_canonicalCones;
+	//@}
+
 	/// CHC solver.
 	std::unique_ptr<smtutil::CHCSolverInterface> m_interface;
 
@@ -0,0 +1,175 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/formal/CanonicalHornPrinter.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <algorithm>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::smtutil;
+using namespace solidity::frontend::smt;
+
+namespace
+{
+
+bool isDigits(string const& _text)
+{
+	return !_text.empty() && all_of(_text.begin(), _text.end(), [](char _c) { return '0' <= _c && _c <= '9'; });
+}
+
+bool isNumeral(string const& _text)
+{
+	return isDigits(boost::starts_with(_text, "-") ? _text.substr(1) : _text);
+}
+
+/// @returns true if @a _expr is a value of the error flag of SymbolicState.
+/// The names of all other variables end in an AST ID and an SSA index.
+bool isErrorFlag(smtutil::Expression const& _expr)
+{
+	return
+		_expr.arguments.empty() &&
+		boost::starts_with(_expr.name, "error_") &&
+		isDigits(_expr.name.substr(6));
+}
+
+/// @returns true if @a _expr is a constant that can be the ID of a verification target.
+/// Zero means that no error happened.
+bool isErrorId(smtutil::Expression const& _expr)
+{
+	return _expr.arguments.empty() && isDigits(_expr.name) && _expr.name != "0";
+}
+
+bool isBuiltin(string const& _name)
+{
+	static set<string> const builtins{
+		"true", "false", "ite", "not", "and", "or", "=>", "implies", "=", "<", "<=", ">", ">=",
+		"+", "-", "*", "/", "div", "mod",
+		"bvnot", "bvand", "bvor", "bvxor", "bvshl", "bvlshr", "bvashr", "int2bv", "bv2int",
+		"select", "store", "const_array", "tuple_get", "tuple_constructor"
+	};
+	return builtins.count(_name);
+}
+
+}
+
+string CanonicalHornPrinter::print(smtutil::Expression const& _expr)
+{
+	if (_expr.arguments.empty())
+	{
+		if (_expr.sort->kind == Kind::Sort)
+			return "(sort " + sort(*dynamic_cast<SortSort const&>(*_expr.sort).inner) + ")";
+		if (_expr.name == "true" || _expr.name == "false" || isNumeral(_expr.name))
+			return _expr.name;
+		return symbol(_expr.name, *_expr.sort);
+	}
+
+	string result = "(";
+	if (!isBuiltin(_expr.name))
+		result += symbol(_expr.name, *_expr.sort);
+	else if (_expr.name == "tuple_constructor")
+		result += _expr.name + ":" + sort(*_expr.sort);
+	else
+		result += _expr.name;
+
+	if (_expr.name == "=" && _expr.arguments.size() == 2)
+	{
+		auto const& lhs = _expr.arguments[0];
+		auto const& rhs = _expr.arguments[1];
+		if (isErrorFlag(lhs) && isErrorId(rhs))
+			return result + " " + print(lhs) + " " + errorId(rhs.name) + ")";
+		if (isErrorId(lhs) && isErrorFlag(rhs))
+			return result + " " + errorId(lhs.name) + " " + print(rhs) + ")";
+	}
+
+	for (auto const& argument: _expr.arguments)
+		result += " " + print(argument);
+	return result + ")";
+}
+
+string CanonicalHornPrinter::symbol(string const& _name, Sort const& _sort)
+{
+	if (m_symbols.count(_name))
+		return m_symbols.at(_name);
+	string canonicalName = "s" + to_string(m_symbols.size());
+	m_symbols.emplace(_name, canonicalName);
+	return canonicalName + ":" + sort(_sort);
+}
+
+string CanonicalHornPrinter::errorId(string const& _id)
+{
+	auto [it, inserted] = m_errorIds.emplace(_id, "#" + to_string(m_errorIds.size()));
+	return it->second;
+}
+
+string CanonicalHornPrinter::sort(Sort const& _sort)
+{
+	string result;
+	switch (_sort.kind)
+	{
+	case Kind::Int:
+		result = "Int";
+		break;
+	case Kind::Bool:
+		result = "Bool";
+		break;
+	case Kind::BitVector:
+		result = "(BitVec " + to_string(dynamic_cast<BitVectorSort const&>(_sort).size) + ")";
+		break;
+	case Kind::Function:
+	{
+		auto const& functionSort = dynamic_cast<FunctionSort const&>(_sort);
+		result = "(Function (";
+		for (auto const& domain: functionSort.domain)
+			result += " " + sort(*domain);
+		result += ") " + sort(*functionSort.codomain) + ")";
+		break;
+	}
+	case Kind::Array:
+	{
+		auto const& arraySort = dynamic_cast<ArraySort const&>(_sort);
+		result = "(Array " + sort(*arraySort.domain) + " " + sort(*arraySort.range) + ")";
+		break;
+	}
+	case Kind::Sort:
+		result = "(Sort " + sort(*dynamic_cast<SortSort const&>(_sort).inner) + ")";
+		break;
+	case Kind::Tuple:
+	{
+		auto const& tupleSort = dynamic_cast<TupleSort const&>(_sort);
+		// Tuple sorts may contain themselves, so their components are only printed once.
+		if (m_tuples.count(tupleSort.name))
+			result = m_tuples.at(tupleSort.name);
+		else
+		{
+			result = "t" + to_string(m_tuples.size());
+			m_tuples.emplace(tupleSort.name, result);
+			result = "(Tuple " + result;
+			for (auto const& component: tupleSort.components)
+				result += " " + sort(*component);
+			result += ")";
+		}
+		break;
+	}
+	}
+	return result;
+}
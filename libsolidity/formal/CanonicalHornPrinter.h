@@ -0,0 +1,57 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#pragma once
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <map>
+#include <string>
+
+namespace solidity::frontend::smt
+{
+
+/**
+ * Prints Horn clauses in a form that does not depend on the AST IDs and counters
+ * the CHC encoding uses in the names of predicates, variables and sorts, so that
+ * the encoding of a contract keeps its form if code is added to or removed from
+ * other contracts.
+ *
+ * Every symbol and tuple sort is renamed to the position at which it first appeared,
+ * which renames them injectively. The IDs of verification targets, which only occur
+ * as values the error flag is compared to, are numbered in the same way. Two sets of
+ * clauses with the same canonical form are therefore equal up to renaming and have
+ * the same models. The sort of a symbol is printed where the symbol first appears.
+ */
+class CanonicalHornPrinter
+{
+public:
+	/// @returns the canonical form of @a _expr. The numbering continues across calls.
+	std::string print(smtutil::Expression const& _expr);
+
+private:
+	std::string symbol(std::string const& _name, smtutil::Sort const& _sort);
+	std::string errorId(std::string const& _id);
+	std::string sort(smtutil::Sort const& _sort);
+
+	std::map<std::string, std::string> m_symbols;
+	std::map<std::string, std::string> m_errorIds;
+	std::map<std::string, std::string> m_tuples;
+};
+
+}
@@ -18,8 +18,10 @@
 
 #pragma once
 
+#include <libsmtutil/QueryCache.h>
 #include <libsmtutil/SolverInterface.h>
 
+#include <memory>
 #include <optional>
 #include <set>
 
@@ -72,6 +74,13 @@ struct ModelCheckerSettings
 	ModelCheckerEngine engine = ModelCheckerEngine::All();
 	ModelCheckerTargets targets = ModelCheckerTargets::All();
 	std::optional<unsigned> timeout;
+	/// If true, BMC queries are sent to all solvers concurrently and the first answer is used,
+	/// instead of querying the solvers one after another and reporting conflicting answers.
+	bool raceSolvers = false;
+	/// Maximum number of threads used to check the verification targets of the BMC engine.
+	size_t threads = 1;
+	/// Optional on-disk cache for the answers of the SMT solvers that run in-process.
+	std::shared_ptr<smtutil::QueryCache> queryCache;
 };
 
 }
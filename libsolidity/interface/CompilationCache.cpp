@@ -0,0 +1,86 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace fs = boost::filesystem;
+
+optional<Json::Value> CompilationCache::load(util::h256 const& _key) const
+{
+	fs::path path = entryPath(_key);
+	boost::system::error_code error;
+	if (!fs::is_regular_file(path, error))
+		return nullopt;
+
+	Json::Value entry;
+	try
+	{
+		if (!util::jsonParseStrict(util::readFileAsString(path.string()), entry) || !entry.isObject())
+			return nullopt;
+	}
+	catch (util::FileNotFound const&)
+	{
+		return nullopt;
+	}
+	return entry;
+}
+
+void CompilationCache::store(util::h256 const& _key, Json::Value const& _entry) const
+{
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (error)
+		return;
+
+	// Write to a temporary file first and rename it afterwards, so that concurrent
+	// compiler runs never see partially written entries.
+	fs::path path = entryPath(_key);
+	fs::path temporaryPath = fs::unique_path(path.string() + ".%%%%-%%%%-%%%%", error);
+	if (error)
+		return;
+	{
+		ofstream output(temporaryPath.string(), ios::out | ios::binary | ios::trunc);
+		output << util::jsonCompactPrint(_entry);
+		if (!output.good())
+		{
+			output.close();
+			fs::remove(temporaryPath, error);
+			return;
+		}
+	}
+	fs::rename(temporaryPath, path, error);
+	if (error)
+		fs::remove(temporaryPath, error);
+}
+
+fs::path CompilationCache::entryPath(util::h256 const& _key) const
+{
+	return m_directory / (_key.hex() + ".json");
+}
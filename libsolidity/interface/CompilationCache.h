@@ -0,0 +1,60 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Persistent storage for compilation results.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <json/json.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <optional>
+
+namespace solidity::frontend
+{
+
+/**
+ * Content-addressed storage for the compilation results of single contracts,
+ * kept as one JSON file per entry in a directory.
+ * The key has to cover everything the stored results depend on, see CompilerStack.
+ * Entries that cannot be read are treated as missing and failures to write are ignored,
+ * so the cache never causes a compilation to fail.
+ */
+class CompilationCache
+{
+public:
+	explicit CompilationCache(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	/// @returns the entry stored under @a _key or nullopt if there is no valid entry.
+	std::optional<Json::Value> load(util::h256 const& _key) const;
+	/// Stores @a _entry under @a _key, replacing any previous entry.
+	void store(util::h256 const& _key, Json::Value const& _entry) const;
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+
+	boost::filesystem::path m_directory;
+};
+
+}
@@ -47,6 +47,7 @@
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/formal/ModelChecker.h>
 #include <libsolidity/interface/ABI.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/Natspec.h>
 #include <libsolidity/interface/GasEstimator.h>
 #include <libsolidity/interface/StorageLayout.h>
@@ -74,6 +75,11 @@
 #include <json/json.h>
 
 #include <boost/algorithm/string/replace.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include <utility>
 
 using namespace std;
@@ -86,6 +92,40 @@ using solidity::util::toHex;
 
 static int g_compilerStackCounts = 0;
 
+namespace
+{
+
+/// Adds @a _offset to the IDs of all nodes of @a _ast.
+void shiftNodeIDs(ASTNode& _ast, int64_t _offset)
+{
+	struct NodeIDShifter: ASTVisitor
+	{
+		explicit NodeIDShifter(int64_t _offset): offset(_offset) {}
+		bool visitNode(ASTNode& _node) override
+		{
+			_node.shiftID(offset);
+			return true;
+		}
+		bool visit(ElementaryTypeNameExpression& _node) override
+		{
+			// The type name is not visited as a child node.
+			const_cast<ElementaryTypeName&>(_node.type()).shiftID(offset);
+			return visitNode(_node);
+		}
+		bool visit(ImportDirective& _node) override
+		{
+			// The imported symbols are not visited as child nodes.
+			for (auto const& symbolAlias: _node.symbolAliases())
+				symbolAlias.symbol->shiftID(offset);
+			return visitNode(_node);
+		}
+		int64_t offset;
+	} shifter{_offset};
+	_ast.accept(shifter);
+}
+
+}
+
 CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
 	m_readFile{std::move(_readFile)},
 	m_enabledSMTSolvers{smtutil::SMTSolverChoice::All()},
@@ -139,6 +179,21 @@ void CompilerStack::setViaIR(bool _viaIR)
 	m_viaIR = _viaIR;
 }
 
+void CompilerStack::setThreadCount(size_t _threadCount)
+{
+	if (m_stackState >= ParsedAndImported)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set thread count before parsing."));
+	solAssert(_threadCount > 0, "");
+	m_threadCount = _threadCount;
+}
+
+void CompilerStack::setCompilationCache(shared_ptr<CompilationCache> _cache)
+{
+	if (m_stackState >= ParsedAndImported)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set compilation cache before parsing."));
+	m_compilationCache = move(_cache);
+}
+
 void CompilerStack::setEVMVersion(langutil::EVMVersion _version)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -222,21 +277,28 @@ void CompilerStack::reset(bool _keepSettings)
 		m_remappings.clear();
 		m_libraries.clear();
 		m_viaIR = false;
+		m_threadCount = 1;
+		m_compilationCache.reset();
 		m_evmVersion = langutil::EVMVersion();
 		m_modelCheckerSettings = ModelCheckerSettings{};
 		m_enabledSMTSolvers = smtutil::SMTSolverChoice::All();
 		m_generateIR = false;
 		m_generateEwasm = false;
+		m_generateYulOptimizerProfile = false;
 		m_revertStrings = RevertStrings::Default;
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
 		m_metadataHash = MetadataHash::IPFS;
 		m_stopAfter = State::CompilationSuccessful;
 	}
+	m_resolver.reset();
 	m_globalContext.reset();
 	m_sourceOrder.clear();
 	m_contracts.clear();
 	m_errorReporter.clear();
+	m_retiredASTs.clear();
+	m_analysisWarnings.clear();
+	m_lastNodeID = 0;
 	TypeProvider::reset();
 }
 
@@ -251,6 +313,78 @@ void CompilerStack::setSources(StringMap _sources)
 	m_stackState = SourcesSet;
 }
 
+void CompilerStack::updateSources(StringMap const& _sources)
+{
+	if (m_importedSources)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Cannot update imported sources."));
+
+	// A source has to be parsed and analysed again if it changed, if its previous analysis
+	// did not succeed or if it imports such a source.
+	set<string> affected;
+	for (auto const& [name, content]: _sources)
+		if (!m_sources.count(name) || m_sources.at(name).scanner->charStream()->source() != content)
+			affected.insert(name);
+	map<string, set<string>> importers;
+	for (auto const& [name, source]: m_sources)
+		if (!source.analysed)
+			affected.insert(name);
+		else
+			for (auto const* import: ASTNode::filteredNodes<ImportDirective>(source.ast->nodes()))
+				importers[*import->annotation().absolutePath].insert(name);
+
+	vector<string> toVisit(affected.begin(), affected.end());
+	while (!toVisit.empty())
+	{
+		string name = move(toVisit.back());
+		toVisit.pop_back();
+		for (string const& importer: importers[name])
+			if (affected.insert(importer).second)
+				toVisit.push_back(importer);
+	}
+
+	size_t keptSources = 0;
+	for (auto const& source: m_sources)
+		if (!affected.count(source.first))
+			++keptSources;
+
+	// Start from scratch if nothing can be kept or if the retired ASTs outnumber the current
+	// ones. The latter bounds the memory taken by the ASTs that are no longer used.
+	if (keptSources == 0 || m_retiredASTs.size() >= m_sources.size())
+	{
+		StringMap sources;
+		for (auto const& [name, source]: m_sources)
+			sources[name] = source.scanner->charStream()->source();
+		for (auto const& [name, content]: _sources)
+			sources[name] = content;
+		reset(true);
+		setSources(move(sources));
+		return;
+	}
+
+	langutil::ErrorList keptWarnings;
+	for (auto const& warning: m_analysisWarnings)
+		if (SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*warning))
+			if (location->source && !affected.count(location->source->name()))
+				keptWarnings.push_back(warning);
+	swap(m_analysisWarnings, keptWarnings);
+
+	for (string const& name: affected)
+	{
+		string content = _sources.count(name) ? _sources.at(name) : m_sources.at(name).scanner->charStream()->source();
+		Source& source = m_sources[name];
+		if (source.ast)
+			m_retiredASTs.emplace_back(move(source.ast));
+		source.reset();
+		source.scanner = make_shared<Scanner>(CharStream(move(content), name));
+	}
+
+	m_sourceOrder.clear();
+	m_contracts.clear();
+	m_unhandledSMTLib2Queries.clear();
+	m_hasError = false;
+	m_stackState = SourcesSet;
+}
+
 bool CompilerStack::parse()
 {
 	if (m_stackState != SourcesSet)
@@ -259,19 +393,43 @@ bool CompilerStack::parse()
 
 	if (SemVerVersion{string(VersionString)}.isPrerelease())
 		m_errorReporter.warning(3805_error, "This is a pre-release compiler version, please do not use it in production.");
+	m_errorReporter.append(m_analysisWarnings);
 
 	Parser parser{m_errorReporter, m_evmVersion, m_parserErrorRecovery};
+	parser.continueNodeIDsAfter(m_lastNodeID);
 
 	vector<string> sourcesToParse;
 	for (auto const& s: m_sources)
-		sourcesToParse.push_back(s.first);
+		// Sources kept by updateSources() are already parsed.
+		if (!s.second.ast)
+			sourcesToParse.push_back(s.first);
 
+	// Sources parsed ahead of time by parseConcurrently(), merged in order below.
+	map<string, ParsedSource> parsedSources;
 	for (size_t i = 0; i < sourcesToParse.size(); ++i)
 	{
 		string const& path = sourcesToParse[i];
 		Source& source = m_sources[path];
-		source.scanner->reset();
-		source.ast = parser.parse(source.scanner);
+		if (m_threadCount > 1 && !parsedSources.count(path) && i + 1 < sourcesToParse.size())
+			parsedSources = parseConcurrently({sourcesToParse.begin() + static_cast<ptrdiff_t>(i), sourcesToParse.end()});
+		auto parsed = parsedSources.find(path);
+		// If the errors reach the limits of the reporter, the sequential parser would have stopped
+		// reporting them or aborted, so the source is parsed again to get the same result.
+		if (parsed != parsedSources.end() && m_errorReporter.appendWithinLimits(parsed->second.errors))
+		{
+			if (parsed->second.exception)
+				rethrow_exception(parsed->second.exception);
+			source.ast = move(parsed->second.ast);
+			// Assign the IDs the nodes would have got from the sequential parser.
+			if (source.ast)
+				shiftNodeIDs(*source.ast, parser.lastNodeID());
+			parser.continueNodeIDsAfter(parser.lastNodeID() + parsed->second.lastNodeID);
+		}
+		else
+		{
+			source.scanner->reset();
+			source.ast = parser.parse(source.scanner);
+		}
 		if (!source.ast)
 			solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
 		else
@@ -287,6 +445,7 @@ bool CompilerStack::parse()
 				}
 		}
 	}
+	m_lastNodeID = parser.lastNodeID();
 
 	if (m_stopAfter <= Parsed)
 		m_stackState = Parsed;
@@ -300,6 +459,45 @@ bool CompilerStack::parse()
 	return !m_hasError;
 }
 
+map<string, CompilerStack::ParsedSource> CompilerStack::parseConcurrently(vector<string> const& _paths)
+{
+	map<string, ParsedSource> parsedSources;
+	for (string const& path: _paths)
+		parsedSources[path];
+
+	// Scanners and parsers do not share any state, apart from the node IDs, which are
+	// assigned relative to the start of the source here.
+	atomic<size_t> nextSource{0};
+	auto worker = [&]()
+	{
+		for (size_t i = nextSource++; i < _paths.size(); i = nextSource++)
+		{
+			ParsedSource& parsed = parsedSources.at(_paths[i]);
+			try
+			{
+				ErrorReporter errorReporter{parsed.errors};
+				Parser parser{errorReporter, m_evmVersion, m_parserErrorRecovery};
+				shared_ptr<Scanner> const& scanner = m_sources.at(_paths[i]).scanner;
+				scanner->reset();
+				parsed.ast = parser.parse(scanner);
+				parsed.lastNodeID = parser.lastNodeID();
+			}
+			catch (...)
+			{
+				parsed.exception = current_exception();
+			}
+		}
+	};
+	vector<thread> threads;
+	for (size_t i = 1; i < min(m_threadCount, _paths.size()); ++i)
+		threads.emplace_back(worker);
+	worker();
+	for (thread& workerThread: threads)
+		workerThread.join();
+
+	return parsedSources;
+}
+
 void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
 {
 	if (m_stackState != Empty)
@@ -328,7 +526,13 @@ bool CompilerStack::analyze()
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call analyze only after parsing was performed."));
 	resolveImports();
 
+	// Sources kept by updateSources() were already analysed.
+	vector<Source const*> sourcesToAnalyse;
 	for (Source const* source: m_sourceOrder)
+		if (!source->analysed)
+			sourcesToAnalyse.push_back(source);
+
+	for (Source const* source: sourcesToAnalyse)
 		if (source->ast)
 			Scoper::assignScopes(*source->ast);
 
@@ -337,37 +541,46 @@ bool CompilerStack::analyze()
 	try
 	{
 		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
 				noErrors = false;
 
 		DocStringTagParser DocStringTagParser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !DocStringTagParser.parseDocStrings(*source->ast))
 				noErrors = false;
 
-		m_globalContext = make_shared<GlobalContext>();
-		// We need to keep the same resolver during the whole process.
-		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
+		// We need to keep the same resolver during the whole process. It is also kept
+		// for updated sources, since they can refer to the scopes of the other sources.
+		if (!m_resolver)
+		{
+			m_globalContext = make_shared<GlobalContext>();
+			m_resolver = make_unique<NameAndTypeResolver>(*m_globalContext, m_evmVersion, m_errorReporter);
+		}
+		NameAndTypeResolver& resolver = *m_resolver;
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !resolver.registerDeclarations(*source->ast))
 				return false;
 
 		map<string, SourceUnit const*> sourceUnitsByName;
 		for (auto& source: m_sources)
 			sourceUnitsByName[source.first] = source.second.ast.get();
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
 				return false;
 
-		resolver.warnHomonymDeclarations();
+		vector<SourceUnit const*> sourceUnits;
+		for (Source const* source: sourcesToAnalyse)
+			if (source->ast)
+				sourceUnits.push_back(source->ast.get());
+		resolver.warnHomonymDeclarations(sourceUnits);
 
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !resolver.resolveNamesAndTypes(*source->ast))
 				return false;
 
 		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !declarationTypeChecker.check(*source->ast))
 				return false;
 
@@ -377,13 +590,13 @@ bool CompilerStack::analyze()
 		// type checker.
 		ContractLevelChecker contractLevelChecker(m_errorReporter);
 
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (auto sourceAst = source->ast)
 				noErrors = contractLevelChecker.check(*sourceAst);
 
 		// Requires ContractLevelChecker
 		DocStringAnalyser docStringAnalyser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !docStringAnalyser.analyseDocStrings(*source->ast))
 				noErrors = false;
 
@@ -395,7 +608,7 @@ bool CompilerStack::analyze()
 		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 		// which is only done one step later.
 		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
+		for (Source const* source: sourcesToAnalyse)
 			if (source->ast && !typeChecker.checkTypeRequirements(*source->ast))
 				noErrors = false;
 
@@ -403,7 +616,7 @@ bool CompilerStack::analyze()
 		{
 			// Checks that can only be done when all types of all AST nodes are known.
 			PostTypeChecker postTypeChecker(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyse)
 				if (source->ast && !postTypeChecker.check(*source->ast))
 					noErrors = false;
 			if (!postTypeChecker.finalize())
@@ -413,7 +626,7 @@ bool CompilerStack::analyze()
 		// Check that immutable variables are never read in c'tors and assigned
 		// exactly once
 		if (noErrors)
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyse)
 				if (source->ast)
 					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 						if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
@@ -424,14 +637,14 @@ bool CompilerStack::analyze()
 			// Control flow graph generator and analyzer. It can check for issues such as
 			// variable is used before it is assigned to.
 			CFG cfg(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyse)
 				if (source->ast && !cfg.constructFlow(*source->ast))
 					noErrors = false;
 
 			if (noErrors)
 			{
 				ControlFlowAnalyzer controlFlowAnalyzer(cfg, m_errorReporter);
-				for (Source const* source: m_sourceOrder)
+				for (Source const* source: sourcesToAnalyse)
 					if (source->ast && !controlFlowAnalyzer.analyze(*source->ast))
 						noErrors = false;
 			}
@@ -441,7 +654,7 @@ bool CompilerStack::analyze()
 		{
 			// Checks for common mistakes. Only generates warnings.
 			StaticAnalyzer staticAnalyzer(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyse)
 				if (source->ast && !staticAnalyzer.analyze(*source->ast))
 					noErrors = false;
 		}
@@ -450,7 +663,7 @@ bool CompilerStack::analyze()
 		{
 			// Check for state mutability in every function.
 			vector<ASTPointer<ASTNode>> ast;
-			for (Source const* source: m_sourceOrder)
+			for (Source const* source: sourcesToAnalyse)
 				if (source->ast)
 					ast.push_back(source->ast);
 
@@ -460,8 +673,10 @@ bool CompilerStack::analyze()
 
 		if (noErrors)
 		{
-			ModelChecker modelChecker(m_errorReporter, m_smtlib2Responses, m_modelCheckerSettings, m_readFile, m_enabledSMTSolvers);
-			for (Source const* source: m_sourceOrder)
+			ModelCheckerSettings modelCheckerSettings = m_modelCheckerSettings;
+			modelCheckerSettings.threads = m_threadCount;
+			ModelChecker modelChecker(m_errorReporter, m_smtlib2Responses, modelCheckerSettings, m_readFile, m_enabledSMTSolvers);
+			for (Source const* source: sourcesToAnalyse)
 				if (source->ast)
 					modelChecker.analyze(*source->ast);
 			m_unhandledSMTLib2Queries += modelChecker.unhandledQueries();
@@ -477,6 +692,13 @@ bool CompilerStack::analyze()
 	m_stackState = AnalysisPerformed;
 	if (!noErrors)
 		m_hasError = true;
+	else if (!m_hasError)
+	{
+		for (auto& source: m_sources)
+			if (util::contains(sourcesToAnalyse, &source.second))
+				source.second.analysed = true;
+		m_analysisWarnings = m_errorReporter.errors();
+	}
 
 	return !m_hasError;
 }
@@ -518,6 +740,11 @@ bool CompilerStack::isRequestedContract(ContractDefinition const& _contract) con
 	return false;
 }
 
+bool CompilerStack::needsCompilation(ContractDefinition const& _contract) const
+{
+	return isRequestedContract(_contract) && !m_contracts.at(_contract.fullyQualifiedName()).loadedFromCache;
+}
+
 bool CompilerStack::compile(State _stopAfter)
 {
 	m_stopAfter = _stopAfter;
@@ -531,59 +758,53 @@ bool CompilerStack::compile(State _stopAfter)
 	if (m_hasError)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Called compile with errors."));
 
-	// Only compile contracts individually which have been requested.
-	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	// Results are only stored if compilation did not report anything, since warnings
+	// issued during code generation would be lost when taking them from the cache.
+	// Imported ASTs are not cached, because their AST IDs are not derived from the sources.
+	// The optimizer statistics are only available if the contracts are actually compiled.
+	bool useCompilationCache = m_compilationCache && !m_importedSources && !m_generateYulOptimizerProfile;
+	size_t errorCount = m_errorReporter.errors().size();
+	if (useCompilationCache)
+		loadFromCompilationCache();
+
+	// The IR based pipelines generate the code of a contract from the IR of the contracts
+	// it creates and thus compile contracts sequentially. They use the threads to optimize
+	// the Yul objects of each contract concurrently instead.
+	if (m_threadCount > 1 && m_generateEvmBytecode && !m_viaIR && !m_generateIR && !m_generateEwasm)
+	{
+		if (!compileContractsInParallel())
+			return false;
+	}
+	else
+	{
+		// Only compile contracts individually which have been requested.
+		map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
 
-	for (Source const* source: m_sourceOrder)
-		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
-				if (isRequestedContract(*contract))
-				{
-					try
-					{
-						if (m_viaIR || m_generateIR || m_generateEwasm)
-							generateIR(*contract);
-						if (m_generateEvmBytecode)
-						{
-							if (m_viaIR)
-								generateEVMFromIR(*contract);
-							else
-								compileContract(*contract, otherCompilers);
-						}
-						if (m_generateEwasm)
-							generateEwasm(*contract);
-					}
-					catch (Error const& _error)
-					{
-						if (_error.type() != Error::Type::CodeGenerationError)
-							throw;
-						m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
-						return false;
-					}
-					catch (UnimplementedFeatureError const& _unimplementedError)
+		for (Source const* source: m_sourceOrder)
+			for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+				if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+					if (needsCompilation(*contract))
 					{
-						if (
-							SourceLocation const* sourceLocation =
-							boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
-						)
-						{
-							string const* comment = _unimplementedError.comment();
-							m_errorReporter.error(
-								1834_error,
-								Error::Type::CodeGenerationError,
-								*sourceLocation,
-								"Unimplemented feature error" +
-								((comment && !comment->empty()) ? ": " + *comment : string{}) +
-								" in " +
-								_unimplementedError.lineInfo()
-							);
+						bool success = reportCodeGenerationErrors([&]() {
+							if (m_viaIR || m_generateIR || m_generateEwasm)
+								generateIR(*contract);
+							if (m_generateEvmBytecode)
+							{
+								if (m_viaIR)
+									generateEVMFromIR(*contract);
+								else
+									compileContract(*contract, otherCompilers);
+							}
+							if (m_generateEwasm)
+								generateEwasm(*contract);
+						});
+						if (!success)
 							return false;
-						}
-						else
-							throw;
 					}
-				}
+	}
 	m_stackState = CompilationSuccessful;
+	if (useCompilationCache && m_errorReporter.errors().size() == errorCount)
+		storeInCompilationCache();
 	this->link();
 	return true;
 }
@@ -751,6 +972,14 @@ string const& CompilerStack::yulIROptimized(string const& _contractName) const
 	return contract(_contractName).yulIROptimized;
 }
 
+Json::Value const& CompilerStack::yulOptimizerProfile(string const& _contractName) const
+{
+	if (m_stackState != CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
+
+	return contract(_contractName).yulOptimizerProfile;
+}
+
 string const& CompilerStack::ewasm(string const& _contractName) const
 {
 	if (m_stackState != CompilationSuccessful)
@@ -1165,6 +1394,210 @@ bool onlySafeExperimentalFeaturesActivated(set<ExperimentalFeature> const& featu
 }
 }
 
+bool CompilerStack::reportCodeGenerationErrors(function<void()> const& _codeGeneration)
+{
+	try
+	{
+		_codeGeneration();
+	}
+	catch (Error const& _error)
+	{
+		if (_error.type() != Error::Type::CodeGenerationError)
+			throw;
+		m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
+		return false;
+	}
+	catch (UnimplementedFeatureError const& _unimplementedError)
+	{
+		if (
+			SourceLocation const* sourceLocation =
+			boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
+		)
+		{
+			string const* comment = _unimplementedError.comment();
+			m_errorReporter.error(
+				1834_error,
+				Error::Type::CodeGenerationError,
+				*sourceLocation,
+				"Unimplemented feature error" +
+				((comment && !comment->empty()) ? ": " + *comment : string{}) +
+				" in " +
+				_unimplementedError.lineInfo()
+			);
+			return false;
+		}
+		else
+			throw;
+	}
+	return true;
+}
+
+namespace
+{
+
+Json::Value linkerObjectToJson(evmasm::LinkerObject const& _object)
+{
+	Json::Value output{Json::objectValue};
+	output["object"] = toHex(_object.bytecode);
+	output["linkReferences"] = Json::objectValue;
+	for (auto const& [offset, name]: _object.linkReferences)
+		output["linkReferences"][to_string(offset)] = name;
+	output["immutableReferences"] = Json::objectValue;
+	for (auto const& [hash, reference]: _object.immutableReferences)
+	{
+		Json::Value& entry = output["immutableReferences"][hash.str()];
+		entry["name"] = reference.first;
+		entry["offsets"] = Json::arrayValue;
+		for (size_t offset: reference.second)
+			entry["offsets"].append(Json::UInt64(offset));
+	}
+	return output;
+}
+
+/// @returns the object stored by linkerObjectToJson or nullopt if @a _input does not have the expected structure.
+/// Throws if values have the right type but are malformed.
+optional<evmasm::LinkerObject> linkerObjectFromJson(Json::Value const& _input)
+{
+	if (
+		!_input.isObject() ||
+		!_input["object"].isString() ||
+		!_input["linkReferences"].isObject() ||
+		!_input["immutableReferences"].isObject()
+	)
+		return nullopt;
+
+	evmasm::LinkerObject object;
+	object.bytecode = util::fromHex(_input["object"].asString(), util::WhenError::Throw);
+	for (auto const& offset: _input["linkReferences"].getMemberNames())
+		object.linkReferences[stoul(offset)] = _input["linkReferences"][offset].asString();
+	for (auto const& hash: _input["immutableReferences"].getMemberNames())
+	{
+		Json::Value const& entry = _input["immutableReferences"][hash];
+		auto& reference = object.immutableReferences[u256(hash)];
+		reference.first = entry["name"].asString();
+		for (auto const& offset: entry["offsets"])
+			reference.second.push_back(offset.asUInt64());
+	}
+	return object;
+}
+
+}
+
+util::h256 CompilerStack::compilationCacheKey(Contract const& _contract) const
+{
+	string key = VersionString + string("\n") + metadata(_contract) + "\n";
+	for (auto const& [name, source]: m_sources)
+		key += name + "\n" + toHex(source.keccak256().asBytes()) + "\n";
+	for (bool flag: {m_generateEvmBytecode, m_generateIR, m_generateEwasm, m_viaIR})
+		key += flag ? "1" : "0";
+	return util::keccak256(key);
+}
+
+void CompilerStack::loadFromCompilationCache()
+{
+	solAssert(m_compilationCache, "");
+	for (Source const* source: m_sourceOrder)
+		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+			if (auto contractDefinition = dynamic_cast<ContractDefinition const*>(node.get()))
+			{
+				if (!contractDefinition->canBeDeployed() || !isRequestedContract(*contractDefinition))
+					continue;
+				Contract& contract = m_contracts.at(contractDefinition->fullyQualifiedName());
+				optional<Json::Value> entry = m_compilationCache->load(compilationCacheKey(contract));
+				if (!entry)
+					continue;
+
+				// Entries that do not have the expected structure are treated as missing.
+				optional<evmasm::LinkerObject> object;
+				optional<evmasm::LinkerObject> runtimeObject;
+				optional<evmasm::LinkerObject> ewasmObject;
+				try
+				{
+					if (m_generateEvmBytecode)
+					{
+						object = linkerObjectFromJson((*entry)["object"]);
+						runtimeObject = linkerObjectFromJson((*entry)["runtimeObject"]);
+						if (!object || !runtimeObject)
+							continue;
+					}
+					if (m_generateEwasm)
+					{
+						ewasmObject = linkerObjectFromJson((*entry)["ewasmObject"]);
+						if (!ewasmObject)
+							continue;
+					}
+				}
+				catch (std::exception const&)
+				{
+					continue;
+				}
+				if (
+					!(*entry)["ir"].isString() ||
+					!(*entry)["irOptimized"].isString() ||
+					!(*entry)["ewasm"].isString() ||
+					(m_generateEvmBytecode && (
+						!(*entry)["generatedSources"].isArray() ||
+						!(*entry)["runtimeGeneratedSources"].isArray()
+					))
+				)
+					continue;
+
+				if (object)
+					contract.object = move(*object);
+				if (runtimeObject)
+					contract.runtimeObject = move(*runtimeObject);
+				if (ewasmObject)
+					contract.ewasmObject = move(*ewasmObject);
+				contract.yulIR = (*entry)["ir"].asString();
+				contract.yulIROptimized = (*entry)["irOptimized"].asString();
+				contract.ewasm = (*entry)["ewasm"].asString();
+				if ((*entry)["sourceMapping"].isString())
+					contract.sourceMapping.emplace((*entry)["sourceMapping"].asString());
+				if ((*entry)["runtimeSourceMapping"].isString())
+					contract.runtimeSourceMapping.emplace((*entry)["runtimeSourceMapping"].asString());
+				if (m_generateEvmBytecode)
+				{
+					contract.generatedSources.init([&]{ return (*entry)["generatedSources"]; });
+					contract.runtimeGeneratedSources.init([&]{ return (*entry)["runtimeGeneratedSources"]; });
+				}
+				contract.loadedFromCache = true;
+			}
+}
+
+void CompilerStack::storeInCompilationCache() const
+{
+	solAssert(m_compilationCache, "");
+	solAssert(m_stackState == CompilationSuccessful, "");
+	for (auto const& [name, contract]: m_contracts)
+	{
+		if (
+			contract.loadedFromCache ||
+			!contract.contract->canBeDeployed() ||
+			!isRequestedContract(*contract.contract)
+		)
+			continue;
+
+		Json::Value entry{Json::objectValue};
+		if (m_generateEvmBytecode)
+		{
+			entry["object"] = linkerObjectToJson(contract.object);
+			entry["runtimeObject"] = linkerObjectToJson(contract.runtimeObject);
+			if (string const* mapping = sourceMapping(name))
+				entry["sourceMapping"] = *mapping;
+			if (string const* mapping = runtimeSourceMapping(name))
+				entry["runtimeSourceMapping"] = *mapping;
+			entry["generatedSources"] = generatedSources(name);
+			entry["runtimeGeneratedSources"] = generatedSources(name, true);
+		}
+		entry["ir"] = contract.yulIR;
+		entry["irOptimized"] = contract.yulIROptimized;
+		entry["ewasm"] = contract.ewasm;
+		if (m_generateEwasm)
+			entry["ewasmObject"] = linkerObjectToJson(contract.ewasmObject);
+		m_compilationCache->store(compilationCacheKey(contract), entry);
+	}
+}
+
 void CompilerStack::compileContract(
 	ContractDefinition const& _contract,
 	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers
@@ -1183,6 +1616,182 @@ void CompilerStack::compileContract(
 	if (!_contract.canBeDeployed())
 		return;
 
+	generateEVMAssembly(_contract, _otherCompilers);
+	assembleEVMCode(_contract, m_threadCount);
+	checkContractCodeSize(_contract);
+
+	Contract const& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	_otherCompilers[compiledContract.contract] = compiledContract.compiler;
+}
+
+bool CompilerStack::compileContractsInParallel()
+{
+	solAssert(m_stackState >= AnalysisPerformed, "");
+	if (m_hasError)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Called compile with errors."));
+
+	// Code generation accesses the AST and the global type provider. It also relies on
+	// all contracts compiled before being available, since dependencies through free
+	// functions or internal library functions are not tracked. Because of that, it runs
+	// for one contract at a time in the same order as in the sequential compilation.
+	// The optimiser and the assembler only access the assemblies, but since the
+	// assembly of a contract is shared with all contracts that create it and is modified
+	// when optimising these, contracts sharing an assembly are optimised in that order, too.
+	struct Job
+	{
+		enum class State { Pending, GeneratingAssembly, AssemblyGenerated, Assembling, Done };
+
+		ContractDefinition const* contract = nullptr;
+		/// All assemblies reachable from the creation assembly of the contract.
+		set<evmasm::Assembly const*> assemblies;
+		/// Indices of the earlier jobs whose assemblies intersect with ours.
+		vector<size_t> conflicts;
+		State state = State::Pending;
+		exception_ptr error;
+	};
+
+	// Jobs are listed in the order in which compileContract() processes the contracts,
+	// i.e. every contract comes after the contracts it depends on.
+	vector<Job> jobs;
+	set<ContractDefinition const*> visited;
+	function<void(ContractDefinition const&)> addJobs = [&](ContractDefinition const& _contract)
+	{
+		if (!visited.insert(&_contract).second)
+			return;
+		for (auto const* dependency: _contract.annotation().contractDependencies)
+			addJobs(*dependency);
+		if (_contract.canBeDeployed())
+		{
+			jobs.emplace_back();
+			jobs.back().contract = &_contract;
+		}
+	};
+	for (Source const* source: m_sourceOrder)
+		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+				if (needsCompilation(*contract))
+					addJobs(*contract);
+
+	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	size_t nextToGenerate = 0;
+	size_t firstFailedJob = jobs.size();
+	size_t runningJobs = 0;
+	mutex jobMutex;
+	condition_variable jobFinished;
+
+	auto isDone = [&](size_t _job) { return jobs[_job].state == Job::State::Done; };
+	auto worker = [&]()
+	{
+		unique_lock<mutex> lock(jobMutex);
+		while (true)
+		{
+			optional<size_t> jobIndex;
+			bool generate = false;
+			if (
+				nextToGenerate < firstFailedJob &&
+				(nextToGenerate == 0 || jobs[nextToGenerate - 1].state != Job::State::GeneratingAssembly)
+			)
+			{
+				jobIndex = nextToGenerate++;
+				generate = true;
+			}
+			else
+				for (size_t i = 0; i < min(nextToGenerate, firstFailedJob) && !jobIndex; ++i)
+					if (
+						jobs[i].state == Job::State::AssemblyGenerated &&
+						all_of(jobs[i].conflicts.begin(), jobs[i].conflicts.end(), isDone)
+					)
+						jobIndex = i;
+
+			if (!jobIndex)
+			{
+				if (runningJobs == 0)
+					break;
+				jobFinished.wait(lock);
+				continue;
+			}
+
+			Job& job = jobs[*jobIndex];
+			job.state = generate ? Job::State::GeneratingAssembly : Job::State::Assembling;
+			++runningJobs;
+			lock.unlock();
+
+			try
+			{
+				if (generate)
+				{
+					// otherCompilers is only modified after generating an assembly, so it is not
+					// modified while we access it.
+					generateEVMAssembly(*job.contract, otherCompilers);
+					Contract const& compiledContract = m_contracts.at(job.contract->fullyQualifiedName());
+					vector<evmasm::Assembly const*> toVisit{compiledContract.evmAssembly.get()};
+					while (!toVisit.empty())
+					{
+						evmasm::Assembly const* assembly = toVisit.back();
+						toVisit.pop_back();
+						if (job.assemblies.insert(assembly).second)
+							for (size_t sub = 0; sub < assembly->numSubs(); ++sub)
+								toVisit.push_back(&assembly->sub(sub));
+					}
+				}
+				else
+					assembleEVMCode(*job.contract, 1);
+			}
+			catch (...)
+			{
+				job.error = current_exception();
+			}
+
+			lock.lock();
+			--runningJobs;
+			if (job.error)
+				firstFailedJob = min(firstFailedJob, *jobIndex);
+			else if (generate)
+			{
+				// All earlier jobs have generated their assemblies by now.
+				for (size_t i = 0; i < *jobIndex; ++i)
+					if (any_of(
+						jobs[i].assemblies.begin(),
+						jobs[i].assemblies.end(),
+						[&](evmasm::Assembly const* _assembly) { return job.assemblies.count(_assembly) > 0; }
+					))
+						job.conflicts.push_back(i);
+				otherCompilers[job.contract] = m_contracts.at(job.contract->fullyQualifiedName()).compiler;
+				job.state = Job::State::AssemblyGenerated;
+			}
+			else
+				job.state = Job::State::Done;
+			jobFinished.notify_all();
+		}
+		jobFinished.notify_all();
+	};
+
+	vector<thread> threads;
+	for (size_t i = 0; i < min(m_threadCount, jobs.size()); ++i)
+		threads.emplace_back(worker);
+	for (thread& workerThread: threads)
+		workerThread.join();
+
+	// Report warnings and errors in the same order as the sequential compilation.
+	for (size_t i = 0; i < firstFailedJob; ++i)
+	{
+		solAssert(isDone(i), "");
+		checkContractCodeSize(*jobs[i].contract);
+	}
+	if (firstFailedJob < jobs.size())
+	{
+		bool success = reportCodeGenerationErrors([&]() { rethrow_exception(jobs[firstFailedJob].error); });
+		solAssert(!success, "");
+		return false;
+	}
+	return true;
+}
+
+void CompilerStack::generateEVMAssembly(
+	ContractDefinition const& _contract,
+	map<ContractDefinition const*, shared_ptr<Compiler const>> const& _otherCompilers
+)
+{
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
 	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
@@ -1190,18 +1799,27 @@ void CompilerStack::compileContract(
 
 	bytes cborEncodedMetadata = createCBORMetadata(compiledContract);
 
+	compiler->generateCode(_contract, _otherCompilers, cborEncodedMetadata);
+	compiledContract.evmAssembly = compiler->assemblyPtr();
+	solAssert(compiledContract.evmAssembly, "");
+	compiledContract.evmRuntimeAssembly = compiler->runtimeAssemblyPtr();
+	solAssert(compiledContract.evmRuntimeAssembly, "");
+}
+
+void CompilerStack::assembleEVMCode(ContractDefinition const& _contract, size_t _threadCount)
+{
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+
 	try
 	{
-		// Run optimiser and compile the contract.
-		compiler->compileContract(_contract, _otherCompilers, cborEncodedMetadata);
+		// Run optimiser.
+		compiledContract.compiler->optimise(_threadCount);
 	}
 	catch(evmasm::OptimizerException const&)
 	{
 		solAssert(false, "Optimizer exception during compilation");
 	}
 
-	compiledContract.evmAssembly = compiler->assemblyPtr();
-	solAssert(compiledContract.evmAssembly, "");
 	try
 	{
 		// Assemble deployment (incl. runtime)  object.
@@ -1213,8 +1831,6 @@ void CompilerStack::compileContract(
 	}
 	solAssert(compiledContract.object.immutableReferences.empty(), "Leftover immutables.");
 
-	compiledContract.evmRuntimeAssembly = compiler->runtimeAssemblyPtr();
-	solAssert(compiledContract.evmRuntimeAssembly, "");
 	try
 	{
 		// Assemble runtime object.
@@ -1224,6 +1840,11 @@ void CompilerStack::compileContract(
 	{
 		solAssert(false, "Assembly exception for deployed bytecode");
 	}
+}
+
+void CompilerStack::checkContractCodeSize(ContractDefinition const& _contract)
+{
+	Contract const& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
 	// Throw a warning if EIP-170 limits are exceeded:
 	//   If contract creation returns data with length greater than 0x6000 (214 + 213) bytes,
@@ -1240,8 +1861,6 @@ void CompilerStack::compileContract(
 			"Consider enabling the optimizer (with a low \"runs\" value!), "
 			"turning off revert strings, or using libraries."
 		);
-
-	_otherCompilers[compiledContract.contract] = compiler;
 }
 
 void CompilerStack::generateIR(ContractDefinition const& _contract)
@@ -1273,8 +1892,23 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	for (auto const& pair: m_contracts)
 		otherYulSources.emplace(pair.second.contract, pair.second.yulIR);
 
-	IRGenerator generator(m_evmVersion, m_revertStrings, m_optimiserSettings);
-	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(_contract, otherYulSources);
+	IRGenerator generator(
+		m_evmVersion,
+		m_revertStrings,
+		m_optimiserSettings,
+		m_threadCount,
+		m_generateYulOptimizerProfile
+	);
+	shared_ptr<yul::Object> optimizedObject;
+	tie(compiledContract.yulIR, optimizedObject) = generator.run(_contract, otherYulSources);
+	if (m_generateYulOptimizerProfile)
+		compiledContract.yulOptimizerProfile["ir"] = generator.optimiserProfile();
+	// Code generation for EVM takes the object directly, the text form is only
+	// needed for the output and for Ewasm.
+	if (m_generateIR || m_generateEwasm)
+		compiledContract.yulIROptimized = generator.print(*optimizedObject);
+	if (m_viaIR && m_generateEvmBytecode)
+		compiledContract.yulIROptimizedObject = move(optimizedObject);
 }
 
 void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
@@ -1287,14 +1921,20 @@ void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
 	if (!compiledContract.object.bytecode.empty())
 		return;
+	solAssert(compiledContract.yulIROptimizedObject, "");
 
-	// Re-parse the Yul IR in EVM dialect
+	// Continue with the Yul object produced by the IR generator.
+	// The stack takes ownership, the optimizer modifies it in place.
 	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
+	stack.importAnalyzed("", move(compiledContract.yulIROptimizedObject));
+	compiledContract.yulIROptimizedObject.reset();
+	stack.setThreadCount(m_threadCount);
+	stack.enableOptimiserProfile(m_generateYulOptimizerProfile);
 	stack.optimize();
+	if (m_generateYulOptimizerProfile)
+		compiledContract.yulOptimizerProfile["bytecode"] = stack.optimiserProfile();
 
 	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
 
@@ -1616,7 +2256,7 @@ Json::Value gasToJson(GasEstimator::GasConsumption const& _gas)
 
 }
 
-Json::Value CompilerStack::gasEstimates(string const& _contractName) const
+Json::Value CompilerStack::gasEstimates(string const& _contractName, optional<size_t> _maxSteps) const
 {
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
@@ -1625,7 +2265,7 @@ Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 		return Json::Value();
 
 	using Gas = GasEstimator::GasConsumption;
-	GasEstimator gasEstimator(m_evmVersion);
+	GasEstimator gasEstimator(m_evmVersion, _maxSteps.value_or(evmasm::PathGasMeter::c_defaultMaxSteps));
 	Json::Value output(Json::objectValue);
 
 	if (evmasm::AssemblyItems const* items = assemblyItems(_contractName))
@@ -46,8 +46,10 @@
 #include <boost/noncopyable.hpp>
 #include <json/json.h>
 
+#include <exception>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <ostream>
 #include <set>
 #include <string>
@@ -66,6 +68,11 @@ class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 }
 
+namespace solidity::yul
+{
+struct Object;
+}
+
 namespace solidity::frontend
 {
 
@@ -75,7 +82,9 @@ class ContractDefinition;
 class FunctionDefinition;
 class SourceUnit;
 class Compiler;
+class CompilationCache;
 class GlobalContext;
+class NameAndTypeResolver;
 class Natspec;
 class DeclarationContainer;
 
@@ -166,6 +175,20 @@ public:
 	/// Must be set before parsing.
 	void setViaIR(bool _viaIR);
 
+	/// Sets the maximum number of threads used for parsing and code generation. If this is larger
+	/// than one, sources are parsed and contracts that do not depend on each other are compiled concurrently.
+	/// The sub-assemblies of a contract are also optimised concurrently, and so are the queries of
+	/// the BMC model checker engine if an SMT solver is available.
+	/// Must be set before parsing.
+	void setThreadCount(size_t _threadCount);
+
+	/// Sets the cache from which the results of unchanged contracts are taken instead of
+	/// compiling them, and in which the results of newly compiled contracts are stored.
+	/// Only results that can be restored completely are cached, so the caller has to make sure
+	/// that assembly output and gas estimates, which need the assembly, are not requested.
+	/// Must be set before parsing.
+	void setCompilationCache(std::shared_ptr<CompilationCache> _cache);
+
 	/// Set the EVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
 	/// Must be set before parsing.
@@ -194,6 +217,10 @@ public:
 	/// Enable experimental generation of Ewasm code. If enabled, IR is also generated.
 	void enableEwasmGeneration(bool _enable = true) { m_generateEwasm = _enable; }
 
+	/// Enable collecting the time spent in the steps of the Yul optimizer and their effect
+	/// on the code size. Contracts are not taken from the compilation cache if enabled.
+	void enableYulOptimizerProfile(bool _enable = true) { m_generateYulOptimizerProfile = _enable; }
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
 	/// Must be set before parsing.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
@@ -206,6 +233,15 @@ public:
 	/// Sets the sources. Must be set before parsing.
 	void setSources(StringMap _sources);
 
+	/// Replaces the contents of the given sources, adding those that do not exist yet, after
+	/// analysis was performed. The next call to parseAndAnalyze() only parses and analyses the
+	/// changed sources and the sources that (transitively) import them, all other sources keep
+	/// their ASTs, annotations and warnings. Sources are always analysed again if their previous
+	/// analysis did not succeed. All compilation results are discarded and the settings of the
+	/// previous run are kept.
+	/// Note that the AST IDs of the sources parsed again differ from those of a fresh compilation.
+	void updateSources(StringMap const& _sources);
+
 	/// Adds a response to an SMTLib2 query (identified by the hash of the query input).
 	/// Must be set before parsing.
 	void addSMTLib2Response(util::h256 const& _hash, std::string const& _response);
@@ -268,6 +304,12 @@ public:
 	/// @returns the optimized IR representation of a contract.
 	std::string const& yulIROptimized(std::string const& _contractName) const;
 
+	/// @returns the statistics of the Yul optimizer runs for a contract, see enableYulOptimizerProfile.
+	/// The key "ir" holds the run that produces the optimized IR, the key "bytecode" the run
+	/// before EVM code is generated from it (only present with via-IR compilation). Each of them maps the names of the Yul objects
+	/// to their statistics.
+	Json::Value const& yulOptimizerProfile(std::string const& _contractName) const;
+
 	/// @returns the Ewasm text representation of a contract.
 	std::string const& ewasm(std::string const& _contractName) const;
 
@@ -334,7 +376,9 @@ public:
 	bytes cborMetadata(std::string const& _contractName) const;
 
 	/// @returns a JSON representing the estimated gas usage for contract creation, internal and external functions
-	Json::Value gasEstimates(std::string const& _contractName) const;
+	/// @param _maxSteps the maximum number of assembly items processed per estimate, see GasEstimator.
+	/// The default of the gas estimator is used if not given.
+	Json::Value gasEstimates(std::string const& _contractName, std::optional<size_t> _maxSteps = std::nullopt) const;
 
 	/// Overwrites the release/prerelease flag. Should only be used for testing.
 	void overwriteReleaseFlag(bool release) { m_release = release; }
@@ -344,6 +388,8 @@ private:
 	{
 		std::shared_ptr<langutil::Scanner> scanner;
 		std::shared_ptr<SourceUnit> ast;
+		/// True if the AST was analysed without errors, in which case updateSources() can keep it.
+		bool analysed = false;
 		util::h256 mutable keccak256HashCached;
 		util::h256 mutable swarmHashCached;
 		std::string mutable ipfsUrlCached;
@@ -353,6 +399,16 @@ private:
 		std::string const& ipfsUrl() const;
 	};
 
+	/// The result of parsing a source with its own parser, see parseConcurrently().
+	struct ParsedSource
+	{
+		std::shared_ptr<SourceUnit> ast;
+		langutil::ErrorList errors;
+		/// The largest node ID assigned by the parser, which starts counting at one.
+		int64_t lastNodeID = 0;
+		std::exception_ptr exception;
+	};
+
 	/// The state per contract. Filled gradually during compilation.
 	struct Contract
 	{
@@ -364,6 +420,9 @@ private:
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Experimental Yul IR code.
 		std::string yulIROptimized; ///< Optimized experimental Yul IR code.
+		/// Optimized experimental Yul IR object, only kept until EVM code is generated from it.
+		std::shared_ptr<yul::Object> yulIROptimizedObject;
+		Json::Value yulOptimizerProfile{Json::objectValue}; ///< Statistics of the Yul optimizer runs, if enabled.
 		std::string ewasm; ///< Experimental Ewasm text representation
 		evmasm::LinkerObject ewasmObject; ///< Experimental Ewasm code
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
@@ -375,12 +434,16 @@ private:
 		util::LazyInit<Json::Value const> runtimeGeneratedSources;
 		mutable std::optional<std::string const> sourceMapping;
 		mutable std::optional<std::string const> runtimeSourceMapping;
+		bool loadedFromCache = false; ///< Whether the results were taken from the compilation cache.
 	};
 
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
 	/// @a m_readFile and stores the absolute paths of all imports in the AST annotations.
 	/// @returns the newly loaded sources.
 	StringMap loadMissingSources(SourceUnit const& _ast, std::string const& _path);
+	/// Parses the sources at @a _paths concurrently, each with its own parser and error list.
+	/// The node IDs of each AST start after zero, parse() merges the results in order.
+	std::map<std::string, ParsedSource> parseConcurrently(std::vector<std::string> const& _paths);
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	void resolveImports();
 
@@ -393,6 +456,23 @@ private:
 	/// @returns true if the contract is requested to be compiled.
 	bool isRequestedContract(ContractDefinition const& _contract) const;
 
+	/// @returns true if the contract is requested and its results were not taken from the cache.
+	bool needsCompilation(ContractDefinition const& _contract) const;
+
+	/// @returns the key of the contract in the compilation cache. It covers the compiler version,
+	/// all settings (through the metadata), all sources, since the AST IDs and source indices depend
+	/// on them, and the kinds of code that are generated.
+	util::h256 compilationCacheKey(Contract const& _contract) const;
+	/// Restores the results of all requested contracts that are found in the compilation cache.
+	void loadFromCompilationCache();
+	/// Stores the results of all compiled requested contracts in the compilation cache.
+	void storeInCompilationCache() const;
+
+	/// Runs @a _codeGeneration and reports the code generation errors and unimplemented
+	/// features it throws as errors.
+	/// @returns false if such an error was reported.
+	bool reportCodeGenerationErrors(std::function<void()> const& _codeGeneration);
+
 	/// Compile a single contract.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
 	///                        their bytecode if needed. Only filled after they have been compiled.
@@ -401,6 +481,28 @@ private:
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
 	);
 
+	/// Compiles all requested contracts and their dependencies like @a compileContract,
+	/// but runs the optimiser and assembler of independent contracts on up to
+	/// m_threadCount threads. The result is identical to the sequential compilation.
+	/// @returns false on error.
+	bool compileContractsInParallel();
+
+	/// Generates the unoptimised EVM assembly of a single contract.
+	/// All contracts it depends on have to be compiled already.
+	void generateEVMAssembly(
+		ContractDefinition const& _contract,
+		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>> const& _otherCompilers
+	);
+
+	/// Optimises the assembly generated by @a generateEVMAssembly and assembles the deployment
+	/// and runtime object. Does not access the AST.
+	/// @param _threadCount maximum number of threads used to optimise the sub-assemblies,
+	/// which has to be 1 if this runs in a job of @a compileContractsInParallel.
+	void assembleEVMCode(ContractDefinition const& _contract, size_t _threadCount);
+
+	/// Warns if the runtime object of the compiled contract exceeds the limit of EIP-170.
+	void checkContractCodeSize(ContractDefinition const& _contract);
+
 	/// Generate Yul IR for a single contract.
 	/// The IR is stored but otherwise unused.
 	void generateIR(ContractDefinition const& _contract);
@@ -467,6 +569,8 @@ private:
 	RevertStrings m_revertStrings = RevertStrings::Default;
 	State m_stopAfter = State::CompilationSuccessful;
 	bool m_viaIR = false;
+	size_t m_threadCount = 1;
+	std::shared_ptr<CompilationCache> m_compilationCache;
 	langutil::EVMVersion m_evmVersion;
 	ModelCheckerSettings m_modelCheckerSettings;
 	smtutil::SMTSolverChoice m_enabledSMTSolvers;
@@ -474,6 +578,7 @@ private:
 	bool m_generateEvmBytecode = true;
 	bool m_generateIR = false;
 	bool m_generateEwasm = false;
+	bool m_generateYulOptimizerProfile = false;
 	std::map<std::string, util::h160> m_libraries;
 	/// list of path prefix remappings, e.g. mylibrary: github.com/ethereum = /usr/local/ethereum
 	/// "context:prefix=target"
@@ -488,6 +593,15 @@ private:
 	std::map<std::string const, Contract> m_contracts;
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
+	/// Resolver that holds the scopes of all analysed sources, kept for analysing updated sources.
+	std::unique_ptr<NameAndTypeResolver> m_resolver;
+	/// ASTs replaced by updateSources(). They are kept alive because types and scopes refer to them.
+	std::vector<std::shared_ptr<SourceUnit>> m_retiredASTs;
+	/// Warnings of the last successful analysis, those of the sources kept by updateSources()
+	/// are reported again by the next parse().
+	langutil::ErrorList m_analysisWarnings;
+	/// ID of the last AST node created, new ASTs continue after it.
+	int64_t m_lastNodeID = 0;
 	bool m_metadataLiteralSources = false;
 	MetadataHash m_metadataHash = MetadataHash::IPFS;
 	bool m_parserErrorRecovery = false;
@@ -78,7 +78,7 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 		);
 	}
 
-	return PathGasMeter::estimateMax(_items, m_evmVersion, 0, state);
+	return PathGasMeter::estimateMax(_items, m_evmVersion, 0, state, m_maxSteps);
 }
 
 GasEstimator::GasConsumption GasEstimator::functionalEstimation(
@@ -100,7 +100,7 @@ GasEstimator::GasConsumption GasEstimator::functionalEstimation(
 	if (parametersSize > 0)
 		state->feedItem(swapInstruction(parametersSize));
 
-	return PathGasMeter::estimateMax(_items, m_evmVersion, _offset, state);
+	return PathGasMeter::estimateMax(_items, m_evmVersion, _offset, state, m_maxSteps);
 }
 
 set<ASTNode const*> GasEstimator::finestNodesAtLocation(
@@ -27,6 +27,7 @@
 
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
+#include <libevmasm/PathGasMeter.h>
 
 #include <array>
 #include <map>
@@ -46,7 +47,15 @@ public:
 	using ASTGasConsumptionSelfAccumulated =
 		std::map<ASTNode const*, std::array<GasConsumption, 2>>;
 
-	explicit GasEstimator(langutil::EVMVersion _evmVersion): m_evmVersion(_evmVersion) {}
+	/// @param _maxSteps the maximum number of assembly items processed per function estimation,
+	/// the estimate is infinite if it is exceeded.
+	explicit GasEstimator(
+		langutil::EVMVersion _evmVersion,
+		size_t _maxSteps = evmasm::PathGasMeter::c_defaultMaxSteps
+	):
+		m_evmVersion(_evmVersion),
+		m_maxSteps(_maxSteps)
+	{}
 
 	/// @returns the estimated gas consumption by the (public or external) function with the
 	/// given signature. If no signature is given, estimates the maximum gas usage.
@@ -68,6 +77,7 @@ private:
 	/// @returns the set of AST nodes which are the finest nodes at their location.
 	static std::set<ASTNode const*> finestNodesAtLocation(std::vector<ASTNode const*> const& _roots);
 	langutil::EVMVersion m_evmVersion;
+	size_t m_maxSteps;
 };
 
 }
@@ -171,7 +171,7 @@ bool hashMatchesContent(string const& _hash, string const& _content)
 
 bool isArtifactRequested(Json::Value const& _outputSelection, string const& _artifact, bool _wildcardMatchesExperimental)
 {
-	static set<string> experimental{"ir", "irOptimized", "wast", "ewasm", "ewasm.wast"};
+	static set<string> experimental{"ir", "irOptimized", "yulOptimizerProfile", "wast", "ewasm", "ewasm.wast"};
 	for (auto const& selectedArtifactJson: _outputSelection)
 	{
 		string const& selectedArtifact = selectedArtifactJson.asString();
@@ -182,7 +182,7 @@ bool isArtifactRequested(Json::Value const& _outputSelection, string const& _art
 			return true;
 		else if (selectedArtifact == "*")
 		{
-			// "ir", "irOptimized", "wast" and "ewasm.wast" can only be matched by "*" if activated.
+			// "ir", "irOptimized", "yulOptimizerProfile", "wast" and "ewasm.wast" can only be matched by "*" if activated.
 			if (experimental.count(_artifact) == 0 || _wildcardMatchesExperimental)
 				return true;
 		}
@@ -255,7 +255,7 @@ bool isBinaryRequested(Json::Value const& _outputSelection)
 	// This does not include "evm.methodIdentifiers" on purpose!
 	static vector<string> const outputsThatRequireBinaries = vector<string>{
 		"*",
-		"ir", "irOptimized",
+		"ir", "irOptimized", "yulOptimizerProfile",
 		"wast", "wasm", "ewasm.wast", "ewasm.wasm",
 		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
 	} + evmObjectComponents("bytecode") + evmObjectComponents("deployedBytecode");
@@ -287,6 +287,25 @@ bool isEvmBytecodeRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns true if any output was requested that needs the EVM assembly and thus
+/// cannot be provided for contracts taken from the compilation cache.
+bool isEvmAssemblyRequested(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
+	static vector<string> const outputsThatRequireEvmAssembly{
+		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
+	};
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (auto const& output: outputsThatRequireEvmAssembly)
+				if (isArtifactRequested(requests, output, false))
+					return true;
+	return false;
+}
+
 /// @returns true if any Ewasm code was requested. Note that as an exception, '*' does not
 /// yet match "ewasm.wast" or "ewasm"
 bool isEwasmRequested(Json::Value const& _outputSelection)
@@ -304,7 +323,7 @@ bool isEwasmRequested(Json::Value const& _outputSelection)
 }
 
 /// @returns true if any Yul IR was requested. Note that as an exception, '*' does not
-/// yet match "ir" or "irOptimized"
+/// yet match "ir", "irOptimized" or "yulOptimizerProfile"
 bool isIRRequested(Json::Value const& _outputSelection)
 {
 	if (isEwasmRequested(_outputSelection))
@@ -316,7 +335,23 @@ bool isIRRequested(Json::Value const& _outputSelection)
 	for (auto const& fileRequests: _outputSelection)
 		for (auto const& requests: fileRequests)
 			for (auto const& request: requests)
-				if (request == "ir" || request == "irOptimized")
+				if (request == "ir" || request == "irOptimized" || request == "yulOptimizerProfile")
+					return true;
+
+	return false;
+}
+
+/// @returns true if the statistics of the Yul optimizer were requested.
+/// Since they contain timings, "*" never matches them.
+bool isYulOptimizerProfileRequested(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (auto const& request: requests)
+				if (request == "yulOptimizerProfile")
 					return true;
 
 	return false;
@@ -428,13 +463,19 @@ std::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "gasEstimator", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
+std::optional<Json::Value> checkGasEstimatorSettingsKeys(Json::Value const& _input)
+{
+	static set<string> keys{"maxSteps"};
+	return checkKeys(_input, keys, "gasEstimator");
+}
+
 std::optional<Json::Value> checkModelCheckerSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"engine", "targets", "timeout"};
+	static set<string> keys{"engine", "raceSolvers", "targets", "timeout"};
 	return checkKeys(_input, keys, "modelChecker");
 }
 
@@ -925,6 +966,25 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.modelCheckerSettings.timeout = modelCheckerSettings["timeout"].asUInt();
 	}
 
+	if (modelCheckerSettings.isMember("raceSolvers"))
+	{
+		if (!modelCheckerSettings["raceSolvers"].isBool())
+			return formatFatalError("JSONError", "settings.modelChecker.raceSolvers must be a Boolean.");
+		ret.modelCheckerSettings.raceSolvers = modelCheckerSettings["raceSolvers"].asBool();
+	}
+
+	Json::Value const& gasEstimatorSettings = settings.get("gasEstimator", Json::Value());
+
+	if (auto result = checkGasEstimatorSettingsKeys(gasEstimatorSettings))
+		return *result;
+
+	if (gasEstimatorSettings.isMember("maxSteps"))
+	{
+		if (!gasEstimatorSettings["maxSteps"].isUInt() || gasEstimatorSettings["maxSteps"].asUInt() == 0)
+			return formatFatalError("JSONError", "settings.gasEstimator.maxSteps must be a positive integer.");
+		ret.gasEstimatorMaxSteps = gasEstimatorSettings["maxSteps"].asUInt();
+	}
+
 	return { std::move(ret) };
 }
 
@@ -946,11 +1006,15 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
 	compilerStack.setMetadataHash(_inputsAndSettings.metadataHash);
 	compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
+	_inputsAndSettings.modelCheckerSettings.queryCache = m_smtQueryCache;
 	compilerStack.setModelCheckerSettings(_inputsAndSettings.modelCheckerSettings);
 
 	compilerStack.enableEvmBytecodeGeneration(isEvmBytecodeRequested(_inputsAndSettings.outputSelection));
 	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
 	compilerStack.enableEwasmGeneration(isEwasmRequested(_inputsAndSettings.outputSelection));
+	compilerStack.enableYulOptimizerProfile(isYulOptimizerProfileRequested(_inputsAndSettings.outputSelection));
+	if (m_compilationCache && !isEvmAssemblyRequested(_inputsAndSettings.outputSelection))
+		compilerStack.setCompilationCache(m_compilationCache);
 
 	Json::Value errors = std::move(_inputsAndSettings.errors);
 
@@ -1138,6 +1202,8 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			contractData["ir"] = compilerStack.yulIR(contractName);
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
 			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "yulOptimizerProfile", false))
+			contractData["yulOptimizerProfile"] = compilerStack.yulOptimizerProfile(contractName);
 
 		// Ewasm
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ewasm.wast", wildcardMatchesExperimental))
@@ -1154,7 +1220,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
 			evmData["methodIdentifiers"] = compilerStack.methodIdentifiers(contractName);
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
+			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName, _inputsAndSettings.gasEstimatorMaxSteps);
 
 		if (compilationSuccess && isArtifactRequested(
 			_inputsAndSettings.outputSelection,
@@ -1269,7 +1335,12 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 	if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "ir", wildcardMatchesExperimental))
 		output["contracts"][sourceName][contractName]["ir"] = stack.print();
 
+	bool const profileRequested =
+		isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "yulOptimizerProfile", false);
+	stack.enableOptimiserProfile(profileRequested);
 	stack.optimize();
+	if (profileRequested)
+		output["contracts"][sourceName][contractName]["yulOptimizerProfile"]["ir"] = stack.optimiserProfile();
 
 	MachineAssemblyObject object;
 	MachineAssemblyObject runtimeObject;
@@ -42,8 +42,17 @@ public:
 	/// Creates a new StandardCompiler.
 	/// @param _readFile callback used to read files for import statements. Must return
 	/// and must not emit exceptions.
-	explicit StandardCompiler(ReadCallback::Callback _readFile = ReadCallback::Callback()):
-		m_readFile(std::move(_readFile))
+	/// @param _compilationCache optional cache for the results of Solidity contracts. It is not
+	/// used for inputs that request assembly output or gas estimates.
+	/// @param _smtQueryCache optional cache for the answers of the SMT solvers used by the model checker.
+	explicit StandardCompiler(
+		ReadCallback::Callback _readFile = ReadCallback::Callback(),
+		std::shared_ptr<CompilationCache> _compilationCache = {},
+		std::shared_ptr<smtutil::QueryCache> _smtQueryCache = {}
+	):
+		m_readFile(std::move(_readFile)),
+		m_compilationCache(std::move(_compilationCache)),
+		m_smtQueryCache(std::move(_smtQueryCache))
 	{
 	}
 
@@ -72,6 +81,7 @@ private:
 		CompilerStack::MetadataHash metadataHash = CompilerStack::MetadataHash::IPFS;
 		Json::Value outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
+		std::optional<size_t> gasEstimatorMaxSteps;
 		bool viaIR = false;
 	};
 
@@ -83,6 +93,8 @@ private:
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
+	std::shared_ptr<CompilationCache> m_compilationCache;
+	std::shared_ptr<smtutil::QueryCache> m_smtQueryCache;
 };
 
 }
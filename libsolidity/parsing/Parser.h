@@ -49,6 +49,12 @@ public:
 
 	ASTPointer<SourceUnit> parse(std::shared_ptr<langutil::Scanner> const& _scanner);
 
+	/// @returns the ID of the last node created by the parser.
+	int64_t lastNodeID() const { return m_currentNodeID; }
+	/// Makes the parser assign IDs larger than @a _id, so that they do not clash with the IDs
+	/// of an AST created by another parser.
+	void continueNodeIDsAfter(int64_t _id) { m_currentNodeID = _id; }
+
 private:
 	class ASTNodeFactory;
 
@@ -0,0 +1,95 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Size-bounded map that evicts the least recently used entry and can be shared between threads.
+ */
+
+#pragma once
+
+#include <libsolutil/Assertions.h>
+#include <libsolutil/Exceptions.h>
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace solidity::util
+{
+
+/**
+ * Map from @a Key to @a Value that holds at most a fixed number of entries. If it is full,
+ * inserting a new entry removes the entry that was least recently inserted or looked up.
+ * All functions can be called concurrently.
+ */
+template <class Key, class Value>
+class LRUCache
+{
+public:
+	explicit LRUCache(size_t _capacity): m_capacity(_capacity)
+	{
+		assertThrow(m_capacity > 0, Exception, "Cache capacity has to be positive.");
+	}
+
+	/// @returns a copy of the value stored for @a _key or nullopt if there is none.
+	std::optional<Value> get(Key const& _key)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_entries.find(_key);
+		if (it == m_entries.end())
+			return std::nullopt;
+		m_usage.splice(m_usage.end(), m_usage, it->second.second);
+		return it->second.first;
+	}
+
+	/// Stores @a _value for @a _key, replacing a previous value.
+	void set(Key const& _key, Value _value)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_entries.find(_key);
+		if (it != m_entries.end())
+		{
+			it->second.first = std::move(_value);
+			m_usage.splice(m_usage.end(), m_usage, it->second.second);
+			return;
+		}
+		if (m_entries.size() == m_capacity)
+		{
+			m_entries.erase(m_usage.front());
+			m_usage.pop_front();
+		}
+		m_usage.push_back(_key);
+		m_entries.emplace(_key, std::make_pair(std::move(_value), std::prev(m_usage.end())));
+	}
+
+	size_t size() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_entries.size();
+	}
+
+private:
+	size_t const m_capacity;
+	mutable std::mutex m_mutex;
+	/// Keys from least to most recently used.
+	std::list<Key> m_usage;
+	std::map<Key, std::pair<Value, typename std::list<Key>::iterator>> m_entries;
+};
+
+}
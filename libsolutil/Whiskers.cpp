@@ -26,13 +26,272 @@
 
 #include <libsolutil/Assertions.h>
 
-#include <regex>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity::util;
 
+namespace
+{
+
+/// Element of a parsed template.
+struct Node
+{
+	enum class Kind { Text, Tag, List, Condition };
+
+	Kind kind;
+	/// Literal text or name of the parameter. Names of conditions on string parameters include the leading "+".
+	string text;
+	/// Body of the list or the part of the condition used if it is true.
+	vector<Node> body;
+	/// Part of the condition used if it is false.
+	vector<Node> elseBody;
+};
+
+bool isParameterChar(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
+/// Parses templates with the same semantics as the regular expression
+///   <(name)>|<#(name)>(.*?)</\2>|<\?(\+?name)>(.*?)(<!\4>(.*?))?</\4>
+/// which is matched repeatedly from left to right, where ``name`` is a non-empty
+/// sequence of parameter characters. Text that does not match is copied verbatim.
+class Parser
+{
+public:
+	explicit Parser(string const& _text): m_text(_text) {}
+
+	vector<Node> parse(size_t _begin, size_t _end) const
+	{
+		vector<Node> nodes;
+		size_t textStart = _begin;
+		for (size_t pos = m_text.find('<', _begin); pos < _end; pos = m_text.find('<', pos + 1))
+		{
+			optional<pair<Node, size_t>> match = matchAt(pos, _end);
+			if (!match)
+				continue;
+			if (textStart < pos)
+				nodes.push_back({Node::Kind::Text, m_text.substr(textStart, pos - textStart), {}, {}});
+			nodes.emplace_back(move(match->first));
+			textStart = match->second;
+			pos = textStart - 1;
+		}
+		if (textStart < _end)
+			nodes.push_back({Node::Kind::Text, m_text.substr(textStart, _end - textStart), {}, {}});
+		return nodes;
+	}
+
+private:
+	/// @returns the end of the parameter name starting at @a _pos if it is followed by ">".
+	optional<size_t> nameEnd(size_t _pos, size_t _end) const
+	{
+		size_t pos = _pos;
+		while (pos < _end && isParameterChar(m_text[pos]))
+			++pos;
+		if (pos == _pos || pos >= _end || m_text[pos] != '>')
+			return nullopt;
+		return pos;
+	}
+
+	/// @returns the position of @a _needle in the range, if it is fully contained.
+	optional<size_t> find(string const& _needle, size_t _begin, size_t _end) const
+	{
+		size_t pos = m_text.find(_needle, _begin);
+		if (pos == string::npos || pos + _needle.size() > _end)
+			return nullopt;
+		return pos;
+	}
+
+	/// Tries to match a tag, a list or a condition at @a _pos.
+	/// @returns the matched node and the position after the match.
+	optional<pair<Node, size_t>> matchAt(size_t _pos, size_t _end) const
+	{
+		if (_pos + 1 >= _end)
+			return nullopt;
+		char kind = m_text[_pos + 1];
+		if (kind != '#' && kind != '?')
+		{
+			optional<size_t> end = nameEnd(_pos + 1, _end);
+			if (!end)
+				return nullopt;
+			return make_pair(Node{Node::Kind::Tag, m_text.substr(_pos + 1, *end - _pos - 1), {}, {}}, *end + 1);
+		}
+
+		size_t nameStart = _pos + 2;
+		if (kind == '?' && nameStart < _end && m_text[nameStart] == '+')
+			nameStart++;
+		optional<size_t> end = nameEnd(nameStart, _end);
+		if (!end)
+			return nullopt;
+		string name = m_text.substr(_pos + 2, *end - _pos - 2);
+		string closingTag = "</" + name + ">";
+		optional<size_t> closing = find(closingTag, *end + 1, _end);
+		if (!closing)
+			return nullopt;
+
+		Node node{kind == '#' ? Node::Kind::List : Node::Kind::Condition, name, {}, {}};
+		string elseTag = "<!" + name + ">";
+		optional<size_t> elsePos = kind == '?' ? find(elseTag, *end + 1, *closing) : nullopt;
+		node.body = parse(*end + 1, elsePos ? *elsePos : *closing);
+		if (elsePos)
+			node.elseBody = parse(*elsePos + elseTag.size(), *closing);
+		return make_pair(move(node), *closing + closingTag.size());
+	}
+
+	string const& m_text;
+};
+
+}
+
+struct Whiskers::Template
+{
+	explicit Template(string _text): text(move(_text))
+	{
+		nodes = Parser(text).parse(0, text.size());
+		for (size_t pos = text.find('<'); pos != string::npos; pos = text.find('<', pos + 1))
+		{
+			size_t end = pos + 1;
+			if (end < text.size() && (text[end] == '?' || text[end] == '#' || text[end] == '/' || text[end] == '!'))
+				end++;
+			while (end < text.size() && isParameterChar(text[end]))
+				end++;
+			if (end < text.size() && text[end] == '>')
+				tags.insert(text.substr(pos, end + 1 - pos));
+		}
+	}
+
+	string text;
+	vector<Node> nodes;
+	/// All substrings of the form "<name>", "<?name>", "<#name>", "</name>" and "<!name>".
+	set<string> tags;
+};
+
+namespace
+{
+
+/// Renders the parsed template into a single output buffer.
+class Renderer
+{
+public:
+	Renderer(
+		string const& _template,
+		Whiskers::StringMap const& _parameters,
+		map<string, bool> const& _conditions,
+		Whiskers::StringListMap const& _listParameters,
+		string& _output
+	):
+		m_template(_template),
+		m_parameters(_parameters),
+		m_conditions(_conditions),
+		m_listParameters(_listParameters),
+		m_output(_output)
+	{}
+
+	void render(vector<Node> const& _nodes)
+	{
+		for (Node const& node: _nodes)
+			switch (node.kind)
+			{
+			case Node::Kind::Text:
+				m_output += node.text;
+				break;
+			case Node::Kind::Tag:
+			{
+				string const* value = parameter(node.text);
+				assertThrow(
+					value,
+					WhiskersError,
+					"Value for tag " + node.text + " not provided.\n" +
+					"Template:\n" +
+					m_template
+				);
+				m_output += *value;
+				break;
+			}
+			case Node::Kind::List:
+			{
+				// Lists cannot be nested.
+				auto list = m_listElement ? m_listParameters.end() : m_listParameters.find(node.text);
+				assertThrow(
+					list != m_listParameters.end(),
+					WhiskersError, "List parameter " + node.text + " not set."
+				);
+				for (Whiskers::StringMap const& element: list->second)
+				{
+					for (auto const& parameter: element)
+						assertThrow(
+							!m_parameters.count(parameter.first),
+							WhiskersError,
+							"Parameter collision"
+						);
+					m_listElement = &element;
+					render(node.body);
+				}
+				m_listElement = nullptr;
+				break;
+			}
+			case Node::Kind::Condition:
+			{
+				bool conditionValue = false;
+				if (node.text[0] == '+')
+				{
+					string const* value = parameter(node.text.substr(1));
+					assertThrow(
+						value,
+						WhiskersError, "Tag " + node.text.substr(1) + " used as condition but was not set."
+					);
+					conditionValue = !value->empty();
+				}
+				else
+				{
+					auto condition = m_conditions.find(node.text);
+					assertThrow(
+						condition != m_conditions.end(),
+						WhiskersError, "Condition parameter " + node.text + " not set."
+					);
+					conditionValue = condition->second;
+				}
+				render(conditionValue ? node.body : node.elseBody);
+				break;
+			}
+			}
+	}
+
+private:
+	/// @returns the value of a regular parameter or nullptr if it is not set.
+	/// Inside lists, the parameters of the current list element are visible as well.
+	string const* parameter(string const& _name) const
+	{
+		if (m_listElement)
+		{
+			auto it = m_listElement->find(_name);
+			if (it != m_listElement->end())
+				return &it->second;
+		}
+		auto it = m_parameters.find(_name);
+		return it == m_parameters.end() ? nullptr : &it->second;
+	}
+
+	string const& m_template;
+	Whiskers::StringMap const& m_parameters;
+	map<string, bool> const& m_conditions;
+	Whiskers::StringListMap const& m_listParameters;
+	Whiskers::StringMap const* m_listElement = nullptr;
+	string& m_output;
+};
+
+}
+
 Whiskers::Whiskers(string _template):
-	m_template(move(_template))
+	m_template(parse(move(_template)))
 {
 }
 
@@ -71,14 +330,20 @@ Whiskers& Whiskers::operator()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	string result;
+	result.reserve(m_template->text.size());
+	Renderer(m_template->text, m_parameters, m_conditions, m_listParameters, result).render(m_template->nodes);
+	return result;
 }
 
 void Whiskers::checkParameterValid(string const& _parameter) const
 {
-	static regex validParam("^" + paramRegex() + "$");
+	bool valid = !_parameter.empty();
+	for (char c: _parameter)
+		if (!isParameterChar(c))
+			valid = false;
 	assertThrow(
-		regex_match(_parameter, validParam),
+		valid,
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -109,122 +374,31 @@ void Whiskers::checkTemplateContainsTags(string const& _parameter, vector<string
 	{
 		string tag{"<" + prefix + _parameter + ">"};
 		assertThrow(
-			m_template.find(tag) != string::npos,
+			m_template->tags.count(tag),
 			WhiskersError,
-			"Tag '" + tag + "' not found in template:\n" + m_template
+			"Tag '" + tag + "' not found in template:\n" + m_template->text
 		);
 	}
 }
 
-namespace
-{
-template<class ReplaceCallback>
-string regex_replace(
-	string const& _source,
-	regex const& _pattern,
-	ReplaceCallback _replace,
-	regex_constants::match_flag_type _flags = regex_constants::match_default
-)
+shared_ptr<Whiskers::Template const> Whiskers::parse(string _text)
 {
-	sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	sregex_iterator matchEnd;
-	string::const_iterator lastMatchedPos(_source.cbegin());
-	string result;
-	while (curMatch != matchEnd)
-	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
-	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
-}
-}
+	// Most templates are string literals, but some are assembled at runtime,
+	// so the cache is bounded.
+	static size_t const maxCacheSize = 4096;
+	static mutex cacheMutex;
+	static unordered_map<string, shared_ptr<Template const>> cache;
 
-string Whiskers::replace(
-	string const& _template,
-	StringMap const& _parameters,
-	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
-)
-{
-	static regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
 	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
-		{
-			assertThrow(
-				_parameters.count(tagName),
-				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
-				"Template:\n" +
-				_template
-			);
-			return _parameters.at(tagName);
-		}
-		else if (!listName.empty())
-		{
-			string templ(_match[3]);
-			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
-			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
-		}
-		else
-		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
-			bool conditionValue = false;
-			if (conditionName[0] == '+')
-			{
-				string tag = conditionName.substr(1);
-				assertThrow(
-					_parameters.count(tag),
-					WhiskersError, "Tag " + tag + " used as condition but was not set."
-				);
-				conditionValue = !_parameters.at(tag).empty();
-			}
-			else
-			{
-				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
-				);
-				conditionValue = _conditions.at(conditionName);
-			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
-			);
-		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
+		lock_guard<mutex> lock(cacheMutex);
+		auto it = cache.find(_text);
+		if (it != cache.end())
+			return it->second;
+	}
+	auto parsed = make_shared<Template const>(_text);
+	lock_guard<mutex> lock(cacheMutex);
+	if (cache.size() >= maxCacheSize)
+		cache.clear();
+	cache.emplace(move(_text), parsed);
+	return parsed;
 }
-
@@ -28,6 +28,7 @@
 
 #include <string>
 #include <map>
+#include <memory>
 #include <vector>
 
 namespace solidity::util
@@ -66,6 +67,8 @@ DEV_SIMPLE_EXCEPTION(WhiskersError);
  *  - List parameter: <#list>...</list>
  *    The part between the tags is repeated as often as values are provided
  *    in the mapping. Each list element can have its own parameter -> value mapping.
+ *
+ * Templates are parsed only once per template text and the parsed form is cached.
  */
 class Whiskers
 {
@@ -94,25 +97,17 @@ private:
 	void checkParameterValid(std::string const& _parameter) const;
 	void checkParameterUnknown(std::string const& _parameter) const;
 
-	/// Checks whether the string stored in `m_template` contains all the tags specified.
+	/// Checks whether the template contains all the tags specified.
 	/// @param _parameter name of the parameter. This name is used to construct the tag(s).
 	/// @param _prefixes a vector of strings, where each element is used to compose the tag
 	///        like `"<" + element + _parameter + ">"`. Each element of _prefixes is used as a prefix of the tag name.
 	void checkTemplateContainsTags(std::string const& _parameter, std::vector<std::string> const& _prefixes) const;
 
-	static std::string replace(
-		std::string const& _template,
-		StringMap const& _parameters,
-		std::map<std::string, bool> const& _conditions,
-		StringListMap const& _listParameters = StringListMap()
-	);
-
-	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
-
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
+	struct Template;
+	/// @returns the parsed template for @a _text, taken from the cache if it was parsed before.
+	static std::shared_ptr<Template const> parse(std::string _text);
 
-	std::string m_template;
+	std::shared_ptr<Template const> m_template;
 	StringMap m_parameters;
 	std::map<std::string, bool> m_conditions;
 	StringListMap m_listParameters;
@@ -0,0 +1,495 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Fixed-width 256-bit word with the arithmetic of the EVM.
+ */
+
+#pragma once
+
+#include <libsolutil/Common.h>
+
+#include <cstdint>
+#include <limits>
+#include <utility>
+
+namespace solidity::util
+{
+
+/**
+ * Unsigned 256-bit integer stored as four 64-bit limbs (least significant first).
+ * All operations wrap around modulo 2**256 and division or modulo by zero result in zero,
+ * as in the EVM. Signed operations interpret the word as two's complement.
+ *
+ * In contrast to u256, none of the operations allocate or go through the generic
+ * multi-precision code of boost, and all of them can be used in constant expressions.
+ * Values are meant to be converted from and to u256 at the boundaries of the code using it.
+ */
+class Word256
+{
+public:
+	constexpr Word256() = default;
+	constexpr Word256(uint64_t _value): m_limbs{_value, 0, 0, 0} {}
+	constexpr Word256(uint64_t _limb3, uint64_t _limb2, uint64_t _limb1, uint64_t _limb0):
+		m_limbs{_limb0, _limb1, _limb2, _limb3}
+	{}
+	explicit Word256(u256 const& _value);
+
+	explicit operator u256() const;
+
+	/// @returns the limb at @a _index, where zero is the least significant one.
+	constexpr uint64_t limb(size_t _index) const { return m_limbs[_index]; }
+	constexpr bool isZero() const { return (m_limbs[0] | m_limbs[1] | m_limbs[2] | m_limbs[3]) == 0; }
+	constexpr bool fitsUint64() const { return (m_limbs[1] | m_limbs[2] | m_limbs[3]) == 0; }
+	constexpr bool bit(unsigned _index) const { return (m_limbs[_index / 64] >> (_index % 64)) & 1; }
+	constexpr bool isNegative() const { return bit(255); }
+	/// @returns the number of bits required to represent the value, i.e. zero for zero.
+	constexpr unsigned bitLength() const
+	{
+		for (size_t i = 4; i-- > 0;)
+			if (m_limbs[i])
+				return static_cast<unsigned>(64 * i) + bitLength(m_limbs[i]);
+		return 0;
+	}
+
+	constexpr explicit operator bool() const { return !isZero(); }
+
+	friend constexpr bool operator==(Word256 const& _a, Word256 const& _b)
+	{
+		return
+			_a.m_limbs[0] == _b.m_limbs[0] &&
+			_a.m_limbs[1] == _b.m_limbs[1] &&
+			_a.m_limbs[2] == _b.m_limbs[2] &&
+			_a.m_limbs[3] == _b.m_limbs[3];
+	}
+	friend constexpr bool operator!=(Word256 const& _a, Word256 const& _b) { return !(_a == _b); }
+	friend constexpr bool operator<(Word256 const& _a, Word256 const& _b)
+	{
+		for (size_t i = 4; i-- > 0;)
+			if (_a.m_limbs[i] != _b.m_limbs[i])
+				return _a.m_limbs[i] < _b.m_limbs[i];
+		return false;
+	}
+	friend constexpr bool operator>(Word256 const& _a, Word256 const& _b) { return _b < _a; }
+	friend constexpr bool operator<=(Word256 const& _a, Word256 const& _b) { return !(_b < _a); }
+	friend constexpr bool operator>=(Word256 const& _a, Word256 const& _b) { return !(_a < _b); }
+
+	constexpr Word256 operator~() const { return {~m_limbs[3], ~m_limbs[2], ~m_limbs[1], ~m_limbs[0]}; }
+	constexpr Word256 operator-() const { return ~*this + 1; }
+
+	friend constexpr Word256 operator&(Word256 const& _a, Word256 const& _b)
+	{
+		return {_a.m_limbs[3] & _b.m_limbs[3], _a.m_limbs[2] & _b.m_limbs[2], _a.m_limbs[1] & _b.m_limbs[1], _a.m_limbs[0] & _b.m_limbs[0]};
+	}
+	friend constexpr Word256 operator|(Word256 const& _a, Word256 const& _b)
+	{
+		return {_a.m_limbs[3] | _b.m_limbs[3], _a.m_limbs[2] | _b.m_limbs[2], _a.m_limbs[1] | _b.m_limbs[1], _a.m_limbs[0] | _b.m_limbs[0]};
+	}
+	friend constexpr Word256 operator^(Word256 const& _a, Word256 const& _b)
+	{
+		return {_a.m_limbs[3] ^ _b.m_limbs[3], _a.m_limbs[2] ^ _b.m_limbs[2], _a.m_limbs[1] ^ _b.m_limbs[1], _a.m_limbs[0] ^ _b.m_limbs[0]};
+	}
+
+	friend constexpr Word256 operator+(Word256 const& _a, Word256 const& _b)
+	{
+		Word256 result;
+		uint64_t carry = 0;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			uint64_t sum = _a.m_limbs[i] + carry;
+			carry = sum < carry ? 1 : 0;
+			result.m_limbs[i] = sum + _b.m_limbs[i];
+			carry += result.m_limbs[i] < sum ? 1 : 0;
+		}
+		return result;
+	}
+	friend constexpr Word256 operator-(Word256 const& _a, Word256 const& _b)
+	{
+		Word256 result;
+		uint64_t borrow = 0;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			uint64_t difference = _a.m_limbs[i] - _b.m_limbs[i];
+			uint64_t nextBorrow = _a.m_limbs[i] < _b.m_limbs[i] ? 1 : 0;
+			result.m_limbs[i] = difference - borrow;
+			nextBorrow |= difference < borrow ? 1 : 0;
+			borrow = nextBorrow;
+		}
+		return result;
+	}
+	friend constexpr Word256 operator*(Word256 const& _a, Word256 const& _b)
+	{
+		Word256 result;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			uint64_t carry = 0;
+			for (size_t j = 0; i + j < 4; ++j)
+			{
+				auto [low, high] = multiply(_a.m_limbs[i], _b.m_limbs[j]);
+				uint64_t sum = result.m_limbs[i + j] + low;
+				high += sum < low ? 1 : 0;
+				result.m_limbs[i + j] = sum + carry;
+				high += result.m_limbs[i + j] < sum ? 1 : 0;
+				carry = high;
+			}
+		}
+		return result;
+	}
+	friend constexpr Word256 operator/(Word256 const& _a, Word256 const& _b) { return divMod(_a, _b).first; }
+	friend constexpr Word256 operator%(Word256 const& _a, Word256 const& _b) { return divMod(_a, _b).second; }
+
+	friend constexpr Word256 operator<<(Word256 const& _a, unsigned _amount)
+	{
+		if (_amount >= 256)
+			return {};
+		size_t limbShift = _amount / 64;
+		unsigned bitShift = _amount % 64;
+		Word256 result;
+		for (size_t i = limbShift; i < 4; ++i)
+		{
+			result.m_limbs[i] = _a.m_limbs[i - limbShift] << bitShift;
+			if (bitShift && i > limbShift)
+				result.m_limbs[i] |= _a.m_limbs[i - limbShift - 1] >> (64 - bitShift);
+		}
+		return result;
+	}
+	friend constexpr Word256 operator>>(Word256 const& _a, unsigned _amount)
+	{
+		if (_amount >= 256)
+			return {};
+		size_t limbShift = _amount / 64;
+		unsigned bitShift = _amount % 64;
+		Word256 result;
+		for (size_t i = 0; i + limbShift < 4; ++i)
+		{
+			result.m_limbs[i] = _a.m_limbs[i + limbShift] >> bitShift;
+			if (bitShift && i + limbShift + 1 < 4)
+				result.m_limbs[i] |= _a.m_limbs[i + limbShift + 1] << (64 - bitShift);
+		}
+		return result;
+	}
+
+	/// @returns the quotient and the remainder of @a _a divided by @a _b, both zero if @a _b is zero.
+	static constexpr std::pair<Word256, Word256> divMod(Word256 const& _a, Word256 const& _b)
+	{
+		if (_b.isZero())
+			return {};
+		if (_a < _b)
+			return {Word256{}, _a};
+		if (_a.fitsUint64())
+			return {_a.m_limbs[0] / _b.m_limbs[0], _a.m_limbs[0] % _b.m_limbs[0]};
+		Word256 quotient;
+		Word256 remainder;
+#ifdef __SIZEOF_INT128__
+		divideLimbs(_a.m_limbs, 4, _b.m_limbs, (_b.bitLength() + 63) / 64, quotient.m_limbs, remainder.m_limbs);
+#else
+		// Binary long division, one quotient bit per step.
+		unsigned shift = _a.bitLength() - _b.bitLength();
+		Word256 divisor = _b << shift;
+		remainder = _a;
+		for (unsigned i = shift + 1; i-- > 0;)
+		{
+			if (remainder >= divisor)
+			{
+				remainder = remainder - divisor;
+				quotient.m_limbs[i / 64] |= uint64_t(1) << (i % 64);
+			}
+			divisor = divisor >> 1;
+		}
+#endif
+		return {quotient, remainder};
+	}
+
+	/// @returns (@a _a * @a _b) % @a _modulus without truncating the product, or zero if @a _modulus is zero.
+	static constexpr Word256 mulMod(Word256 const& _a, Word256 const& _b, Word256 const& _modulus)
+	{
+		if (_modulus.isZero())
+			return {};
+		Word256 remainder;
+#ifdef __SIZEOF_INT128__
+		uint64_t product[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+		for (size_t i = 0; i < 4; ++i)
+		{
+			uint64_t carry = 0;
+			for (size_t j = 0; j < 4; ++j)
+			{
+				uint128 sum = uint128(_a.m_limbs[i]) * _b.m_limbs[j] + product[i + j] + carry;
+				product[i + j] = static_cast<uint64_t>(sum);
+				carry = static_cast<uint64_t>(sum >> 64);
+			}
+			product[i + 4] = carry;
+		}
+		uint64_t quotient[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+		divideLimbs(product, 8, _modulus.m_limbs, (_modulus.bitLength() + 63) / 64, quotient, remainder.m_limbs);
+#else
+		// Double and add, keeping all intermediate values below the modulus.
+		Word256 a = _a % _modulus;
+		Word256 b = _b % _modulus;
+		auto add = [&](Word256 const& _x, Word256 const& _y) {
+			Word256 sum = _x + _y;
+			return (sum < _x || sum >= _modulus) ? sum - _modulus : sum;
+		};
+		for (unsigned i = b.bitLength(); i-- > 0;)
+		{
+			remainder = add(remainder, remainder);
+			if (b.bit(i))
+				remainder = add(remainder, a);
+		}
+#endif
+		return remainder;
+	}
+
+private:
+#ifdef __SIZEOF_INT128__
+	__extension__ typedef unsigned __int128 uint128;
+#endif
+
+	/// @returns the low and the high limb of the full product of @a _a and @a _b.
+	static constexpr std::pair<uint64_t, uint64_t> multiply(uint64_t _a, uint64_t _b)
+	{
+#ifdef __SIZEOF_INT128__
+		uint128 product = uint128(_a) * _b;
+		return {static_cast<uint64_t>(product), static_cast<uint64_t>(product >> 64)};
+#else
+		uint64_t aLow = _a & 0xffffffff;
+		uint64_t aHigh = _a >> 32;
+		uint64_t bLow = _b & 0xffffffff;
+		uint64_t bHigh = _b >> 32;
+		uint64_t lowLow = aLow * bLow;
+		uint64_t middle = aHigh * bLow + (lowLow >> 32);
+		uint64_t middle2 = aLow * bHigh + (middle & 0xffffffff);
+		return {(middle2 << 32) | (lowLow & 0xffffffff), aHigh * bHigh + (middle >> 32) + (middle2 >> 32)};
+#endif
+	}
+
+#ifdef __SIZEOF_INT128__
+	/// Divides the @a _m limbs at @a _dividend by the @a _n limbs at @a _divisor, using Knuth's
+	/// algorithm D (The Art of Computer Programming, Vol. 2, 4.3.1). The most significant limb
+	/// of the divisor must not be zero and @a _m must be at least @a _n.
+	/// Writes the @a _m - @a _n + 1 limbs of the quotient to @a _quotient and the
+	/// @a _n limbs of the remainder to @a _remainder.
+	static constexpr void divideLimbs(
+		uint64_t const* _dividend,
+		size_t _m,
+		uint64_t const* _divisor,
+		size_t _n,
+		uint64_t* _quotient,
+		uint64_t* _remainder
+	)
+	{
+		if (_n == 1)
+		{
+			uint64_t remainder = 0;
+			for (size_t i = _m; i-- > 0;)
+			{
+				uint128 current = (uint128(remainder) << 64) | _dividend[i];
+				_quotient[i] = static_cast<uint64_t>(current / _divisor[0]);
+				remainder = static_cast<uint64_t>(current % _divisor[0]);
+			}
+			_remainder[0] = remainder;
+			return;
+		}
+
+		// Normalize, such that the most significant bit of the divisor is set.
+		unsigned shift = 64 - bitLength(_divisor[_n - 1]);
+		uint64_t divisor[4] = {0, 0, 0, 0};
+		uint64_t dividend[9] = {0, 0, 0, 0, 0, 0, 0, 0, 0};
+		for (size_t i = _n; i-- > 0;)
+			divisor[i] = (_divisor[i] << shift) | (shift && i > 0 ? _divisor[i - 1] >> (64 - shift) : 0);
+		dividend[_m] = shift ? _dividend[_m - 1] >> (64 - shift) : 0;
+		for (size_t i = _m; i-- > 0;)
+			dividend[i] = (_dividend[i] << shift) | (shift && i > 0 ? _dividend[i - 1] >> (64 - shift) : 0);
+
+		for (size_t j = _m - _n + 1; j-- > 0;)
+		{
+			// Estimate the quotient limb from the top two limbs and correct it using the third one.
+			// Afterwards, it is at most one too large.
+			uint128 top = (uint128(dividend[j + _n]) << 64) | dividend[j + _n - 1];
+			uint128 estimate = std::numeric_limits<uint64_t>::max();
+			if (dividend[j + _n] < divisor[_n - 1])
+				estimate = top / divisor[_n - 1];
+			uint128 rest = top - estimate * divisor[_n - 1];
+			while ((rest >> 64) == 0 && estimate * divisor[_n - 2] > ((rest << 64) | dividend[j + _n - 2]))
+			{
+				--estimate;
+				rest += divisor[_n - 1];
+			}
+
+			// Subtract estimate * divisor from the current part of the dividend.
+			uint64_t carry = 0;
+			uint64_t borrow = 0;
+			for (size_t i = 0; i < _n; ++i)
+			{
+				uint128 product = estimate * divisor[i] + carry;
+				carry = static_cast<uint64_t>(product >> 64);
+				uint64_t low = static_cast<uint64_t>(product);
+				uint64_t difference = dividend[i + j] - low;
+				uint64_t nextBorrow = dividend[i + j] < low ? 1 : 0;
+				dividend[i + j] = difference - borrow;
+				borrow = nextBorrow + (difference < borrow ? 1 : 0);
+			}
+			uint64_t difference = dividend[j + _n] - carry;
+			bool negative = dividend[j + _n] < carry || difference < borrow;
+			dividend[j + _n] = difference - borrow;
+
+			_quotient[j] = static_cast<uint64_t>(estimate);
+			if (negative)
+			{
+				// The estimate was one too large, add the divisor back.
+				--_quotient[j];
+				carry = 0;
+				for (size_t i = 0; i < _n; ++i)
+				{
+					uint128 sum = uint128(dividend[i + j]) + divisor[i] + carry;
+					dividend[i + j] = static_cast<uint64_t>(sum);
+					carry = static_cast<uint64_t>(sum >> 64);
+				}
+				dividend[j + _n] += carry;
+			}
+		}
+
+		for (size_t i = 0; i < _n; ++i)
+			_remainder[i] = (dividend[i] >> shift) | (shift ? dividend[i + 1] << (64 - shift) : 0);
+	}
+#endif
+
+	static constexpr unsigned bitLength(uint64_t _value)
+	{
+		unsigned length = 0;
+		for (unsigned step = 32; step > 0; step /= 2)
+			if (_value >> step)
+			{
+				_value >>= step;
+				length += step;
+			}
+		return length + static_cast<unsigned>(_value);
+	}
+
+	uint64_t m_limbs[4] = {0, 0, 0, 0};
+};
+
+/// @returns the quotient of @a _a and @a _b, rounded towards zero, or zero if @a _b is zero (SDIV).
+constexpr Word256 signedDiv(Word256 const& _a, Word256 const& _b)
+{
+	Word256 quotient = (_a.isNegative() ? -_a : _a) / (_b.isNegative() ? -_b : _b);
+	return _a.isNegative() != _b.isNegative() ? -quotient : quotient;
+}
+
+/// @returns the remainder of @a _a divided by @a _b with the sign of @a _a, or zero if @a _b is zero (SMOD).
+constexpr Word256 signedMod(Word256 const& _a, Word256 const& _b)
+{
+	Word256 remainder = (_a.isNegative() ? -_a : _a) % (_b.isNegative() ? -_b : _b);
+	return _a.isNegative() ? -remainder : remainder;
+}
+
+/// @returns true if @a _a is less than @a _b as signed numbers (SLT).
+constexpr bool signedLessThan(Word256 const& _a, Word256 const& _b)
+{
+	if (_a.isNegative() != _b.isNegative())
+		return _a.isNegative();
+	return _a < _b;
+}
+
+/// @returns @a _value shifted to the right by @a _amount bits, keeping the sign (SAR).
+constexpr Word256 arithmeticShiftRight(Word256 const& _value, Word256 const& _amount)
+{
+	if (!_value.isNegative())
+		return _amount >= 256 ? Word256{} : _value >> static_cast<unsigned>(_amount.limb(0));
+	if (_amount >= 256)
+		return ~Word256{};
+	return ~(~_value >> static_cast<unsigned>(_amount.limb(0)));
+}
+
+/// @returns @a _value sign-extended from the byte with index @a _byte, counting from the least
+/// significant byte (SIGNEXTEND).
+constexpr Word256 signExtend(Word256 const& _byte, Word256 const& _value)
+{
+	if (_byte >= 31)
+		return _value;
+	unsigned testBit = static_cast<unsigned>(_byte.limb(0)) * 8 + 7;
+	Word256 mask = (Word256(1) << testBit) - 1;
+	return _value.bit(testBit) ? _value | ~mask : _value & mask;
+}
+
+/// @returns (@a _a + @a _b) % @a _modulus without truncating the sum, or zero if @a _modulus is zero (ADDMOD).
+constexpr Word256 addMod(Word256 const& _a, Word256 const& _b, Word256 const& _modulus)
+{
+	if (_modulus.isZero())
+		return {};
+	Word256 a = _a % _modulus;
+	Word256 b = _b % _modulus;
+	// The sum is less than twice the modulus, so subtracting it once is enough
+	// and the wrap-around of the subtraction cancels a possible overflow of the sum.
+	Word256 sum = a + b;
+	if (sum < a || sum >= _modulus)
+		sum = sum - _modulus;
+	return sum;
+}
+
+/// @returns (@a _a * @a _b) % @a _modulus without truncating the product, or zero if @a _modulus is zero (MULMOD).
+constexpr Word256 mulMod(Word256 const& _a, Word256 const& _b, Word256 const& _modulus)
+{
+	return Word256::mulMod(_a, _b, _modulus);
+}
+
+/// @returns @a _base to the power of @a _exponent modulo 2**256 (EXP).
+constexpr Word256 power(Word256 _base, Word256 const& _exponent)
+{
+	Word256 result = 1;
+	unsigned bits = _exponent.bitLength();
+	for (unsigned i = 0; i < bits; ++i)
+	{
+		if (_exponent.bit(i))
+			result = result * _base;
+		_base = _base * _base;
+	}
+	return result;
+}
+
+inline Word256::Word256(u256 const& _value)
+{
+	using boost::multiprecision::limb_type;
+	if constexpr (sizeof(limb_type) == sizeof(uint64_t))
+	{
+		auto const& backend = _value.backend();
+		for (size_t i = 0; i < backend.size() && i < 4; ++i)
+			m_limbs[i] = backend.limbs()[i];
+	}
+	else
+		for (size_t i = 0; i < 4; ++i)
+			m_limbs[i] = static_cast<uint64_t>((_value >> (64 * i)) & std::numeric_limits<uint64_t>::max());
+}
+
+inline Word256::operator u256() const
+{
+	using boost::multiprecision::limb_type;
+	u256 result;
+	if constexpr (sizeof(limb_type) == sizeof(uint64_t))
+	{
+		auto& backend = result.backend();
+		backend.resize(4, 4);
+		for (size_t i = 0; i < 4; ++i)
+			backend.limbs()[i] = m_limbs[i];
+		backend.normalize();
+	}
+	else
+		for (size_t i = 4; i-- > 0;)
+			result = (result << 64) | m_limbs[i];
+	return result;
+}
+
+}
@@ -45,6 +45,10 @@
 #include <libevmasm/Assembly.h>
 #include <liblangutil/Scanner.h>
 
+#include <atomic>
+#include <functional>
+#include <thread>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -91,6 +95,23 @@ bool AssemblyStack::parseAndAnalyze(std::string const& _sourceName, std::string
 	return analyzeParsed();
 }
 
+void AssemblyStack::importAnalyzed(std::string const& _sourceName, shared_ptr<Object> _object)
+{
+	yulAssert(_object, "");
+	yulAssert(_object->code, "");
+	yulAssert(_object->analysisInfo, "");
+	m_errors.clear();
+	m_scanner = make_shared<Scanner>(CharStream("", _sourceName));
+	m_parserResult = move(_object);
+	m_analysisSuccessful = true;
+}
+
+void AssemblyStack::setThreadCount(size_t _threadCount)
+{
+	yulAssert(_threadCount > 0, "");
+	m_threadCount = _threadCount;
+}
+
 void AssemblyStack::optimize()
 {
 	if (!m_optimiserSettings.runYulOptimiser)
@@ -100,7 +121,62 @@ void AssemblyStack::optimize()
 
 	m_analysisSuccessful = false;
 	yulAssert(m_parserResult, "");
-	optimize(*m_parserResult, true);
+
+	// An object only refers to its sub-objects by name, so all objects can be optimized
+	// independently. They are listed with sub-objects first, which is the order in
+	// which they were optimized sequentially.
+	struct Job
+	{
+		Object* object = nullptr;
+		bool isCreation = false;
+		OptimiserSuiteProfile* profile = nullptr;
+	};
+	vector<Job> jobs;
+	function<void(Object&, bool, string const&)> addJobs = [&](Object& _object, bool _isCreation, string const& _path)
+	{
+		for (auto& subNode: _object.subObjects)
+			if (auto subObject = dynamic_cast<Object*>(subNode.get()))
+				addJobs(*subObject, false, _path + "." + subObject->name.str());
+		jobs.push_back({&_object, _isCreation, m_profileOptimiser ? &m_optimiserProfiles[_path] : nullptr});
+	};
+	addJobs(*m_parserResult, true, m_parserResult->name.str());
+
+	size_t threadCount = min(m_threadCount, jobs.size());
+	if (threadCount <= 1)
+		for (Job const& job: jobs)
+			optimize(*job.object, job.isCreation, job.profile);
+	else
+	{
+		// Make sure the dialect is created before it is accessed concurrently.
+		languageToDialect(m_language, m_evmVersion);
+
+		atomic<size_t> nextObject{0};
+		vector<exception_ptr> errors(jobs.size());
+		auto worker = [&]()
+		{
+			for (size_t i = nextObject++; i < jobs.size(); i = nextObject++)
+				try
+				{
+					optimize(*jobs[i].object, jobs[i].isCreation, jobs[i].profile);
+				}
+				catch (...)
+				{
+					errors[i] = current_exception();
+				}
+		};
+		vector<thread> threads;
+		for (size_t i = 1; i < threadCount; ++i)
+			threads.emplace_back(worker);
+		worker();
+		for (thread& t: threads)
+			t.join();
+
+		// Report the error the sequential optimization would have reported.
+		for (exception_ptr const& error: errors)
+			if (error)
+				rethrow_exception(error);
+	}
+
 	yulAssert(analyzeParsed(), "Invalid source code after optimization.");
 }
 
@@ -168,13 +244,10 @@ void AssemblyStack::compileEVM(AbstractAssembly& _assembly, bool _evm15, bool _o
 	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _evm15, _optimize);
 }
 
-void AssemblyStack::optimize(Object& _object, bool _isCreation)
+void AssemblyStack::optimize(Object& _object, bool _isCreation, OptimiserSuiteProfile* _profile)
 {
 	yulAssert(_object.code, "");
 	yulAssert(_object.analysisInfo, "");
-	for (auto& subNode: _object.subObjects)
-		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
-			optimize(*subObject, false);
 
 	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
 	unique_ptr<GasMeter> meter;
@@ -185,10 +258,20 @@ void AssemblyStack::optimize(Object& _object, bool _isCreation)
 		meter.get(),
 		_object,
 		m_optimiserSettings.optimizeStackAllocation,
-		m_optimiserSettings.yulOptimiserSteps
+		m_optimiserSettings.yulOptimiserSteps,
+		{},
+		_profile
 	);
 }
 
+Json::Value AssemblyStack::optimiserProfile() const
+{
+	Json::Value profiles{Json::objectValue};
+	for (auto const& [path, profile]: m_optimiserProfiles)
+		profiles[path] = profile.toJson();
+	return profiles;
+}
+
 MachineAssemblyObject AssemblyStack::assemble(Machine _machine) const
 {
 	yulAssert(m_analysisSuccessful, "");
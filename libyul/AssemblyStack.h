@@ -27,11 +27,15 @@
 
 #include <libyul/Object.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/optimiser/Suite.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
 #include <libevmasm/LinkerObject.h>
 
+#include <json/json.h>
+
+#include <map>
 #include <memory>
 #include <string>
 
@@ -79,6 +83,18 @@ public:
 	/// Multiple calls overwrite the previous state.
 	bool parseAndAnalyze(std::string const& _sourceName, std::string const& _source);
 
+	/// Uses an already parsed and analyzed object instead of parsing source code, e.g. the
+	/// result of @a parserResult of another stack with the same language and EVM version.
+	/// Multiple calls overwrite the previous state.
+	void importAnalyzed(std::string const& _sourceName, std::shared_ptr<Object> _object);
+
+	/// Sets the maximum number of threads the optimizer uses to optimize the
+	/// object and its sub-objects concurrently.
+	void setThreadCount(size_t _threadCount);
+
+	/// Enables collecting the time spent in the optimizer steps and their effect on the code size.
+	void enableOptimiserProfile(bool _enable = true) { m_profileOptimiser = _enable; }
+
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
 	void optimize();
@@ -104,17 +120,25 @@ public:
 	/// Return the parsed and analyzed object.
 	std::shared_ptr<Object> parserResult() const;
 
+	/// @returns the optimizer statistics of all runs of @a optimize since profiling was enabled.
+	/// The keys are the names of the objects, qualified by the names of their parents.
+	Json::Value optimiserProfile() const;
+
 private:
 	bool analyzeParsed();
 	bool analyzeParsed(yul::Object& _object);
 
 	void compileEVM(yul::AbstractAssembly& _assembly, bool _evm15, bool _optimize) const;
 
-	void optimize(yul::Object& _object, bool _isCreation);
+	/// Optimizes @a _object without its sub-objects.
+	void optimize(yul::Object& _object, bool _isCreation, OptimiserSuiteProfile* _profile);
 
 	Language m_language = Language::Assembly;
 	langutil::EVMVersion m_evmVersion;
 	solidity::frontend::OptimiserSettings m_optimiserSettings;
+	size_t m_threadCount = 1;
+	bool m_profileOptimiser = false;
+	std::map<std::string, OptimiserSuiteProfile> m_optimiserProfiles;
 
 	std::shared_ptr<langutil::Scanner> m_scanner;
 
@@ -0,0 +1,127 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * String abstraction that avoids copies.
+ */
+
+#include <libyul/YulString.h>
+
+#include <libyul/Exceptions.h>
+
+using namespace std;
+using namespace solidity::yul;
+
+YulStringRepository::YulStringRepository()
+{
+	clear();
+}
+
+YulStringRepository::Handle YulStringRepository::stringToHandle(string const& _string)
+{
+	if (_string.empty())
+		return { 0, emptyHash() };
+	uint64_t h = hash(_string);
+	// Use the high bits for the shard, since the low bits select the bucket inside the shard.
+	size_t shardIndex = static_cast<size_t>(h >> (64 - shardBits));
+	Shard& shard = m_shards[shardIndex];
+
+	lock_guard<mutex> lock(shard.mutex);
+	auto range = shard.hashToIndex.equal_range(h);
+	for (auto it = range.first; it != range.second; ++it)
+		if (shard.strings.at(it->second) == _string)
+			return Handle{(it->second << shardBits) | shardIndex, h};
+	size_t index = shard.strings.append(_string);
+	shard.hashToIndex.emplace_hint(range.second, make_pair(h, index));
+
+	return Handle{(index << shardBits) | shardIndex, h};
+}
+
+void YulStringRepository::reset()
+{
+	{
+		lock_guard<mutex> lock(resetCallbacksMutex());
+		for (auto const& cb: resetCallbacks())
+			cb();
+	}
+	instance().clear();
+}
+
+YulStringRepository::ResetCallback::ResetCallback(function<void()> _fun)
+{
+	lock_guard<mutex> lock(YulStringRepository::resetCallbacksMutex());
+	YulStringRepository::resetCallbacks().emplace_back(move(_fun));
+}
+
+void YulStringRepository::clear()
+{
+	for (Shard& shard: m_shards)
+	{
+		lock_guard<mutex> lock(shard.mutex);
+		shard.strings.clear();
+		shard.hashToIndex.clear();
+	}
+	// The empty string is not stored in the hash table, it only reserves ID zero.
+	m_shards[0].strings.append({});
+}
+
+mutex& YulStringRepository::resetCallbacksMutex()
+{
+	static mutex callbacksMutex;
+	return callbacksMutex;
+}
+
+string const& YulStringRepository::StringStorage::at(size_t _index) const
+{
+	yulAssert(_index < size(), "Invalid YulString ID.");
+	auto [block, offset] = position(_index);
+	return m_blocks[block].load(memory_order_acquire)[offset];
+}
+
+size_t YulStringRepository::StringStorage::append(string const& _string)
+{
+	size_t index = m_size.load(memory_order_relaxed);
+	auto [block, offset] = position(index);
+	yulAssert(block < maxBlocks, "YulString repository is full.");
+	string* data = m_blocks[block].load(memory_order_relaxed);
+	if (!data)
+	{
+		data = new string[firstBlockSize << block];
+		m_blocks[block].store(data, memory_order_release);
+	}
+	data[offset] = _string;
+	m_size.store(index + 1, memory_order_release);
+	return index;
+}
+
+void YulStringRepository::StringStorage::clear()
+{
+	for (auto& block: m_blocks)
+		delete[] block.exchange(nullptr);
+	m_size = 0;
+}
+
+pair<size_t, size_t> YulStringRepository::StringStorage::position(size_t _index)
+{
+	// Block ``b`` holds ``firstBlockSize << b`` elements and starts
+	// at index ``firstBlockSize * (2**b - 1)``.
+	size_t scaled = _index / firstBlockSize + 1;
+	size_t block = 0;
+	while (scaled >>= 1)
+		++block;
+	return {block, _index - firstBlockSize * ((size_t(1) << block) - 1)};
+}
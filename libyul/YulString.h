@@ -23,8 +23,11 @@
 
 #include <boost/noncopyable.hpp>
 
+#include <array>
+#include <atomic>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <functional>
@@ -36,6 +39,9 @@ namespace solidity::yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+///
+/// The repository is thread-safe: strings are distributed over several shards by their hash,
+/// each of which is guarded by its own mutex. Looking up the string for an ID does not lock.
 class YulStringRepository
 {
 public:
@@ -51,22 +57,11 @@ public:
 		return inst;
 	}
 
-	Handle stringToHandle(std::string const& _string)
+	Handle stringToHandle(std::string const& _string);
+	std::string const& idToString(size_t _id) const
 	{
-		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
+		return m_shards[_id & (shardCount - 1)].strings.at(_id >> shardBits);
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
 
 	static std::uint64_t hash(std::string const& v)
 	{
@@ -82,40 +77,73 @@ public:
 	}
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
 	/// Clear the repository.
-	/// Use with care - there cannot be any dangling YulString references.
+	/// Use with care - there cannot be any dangling YulString references
+	/// and no other thread may use the repository concurrently.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
-	static void reset()
-	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
-	}
+	static void reset();
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
 	struct ResetCallback
 	{
-		ResetCallback(std::function<void()> _fun)
-		{
-			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
-		}
+		ResetCallback(std::function<void()> _fun);
 	};
 
 private:
-	YulStringRepository() = default;
+	/// Append-only storage for strings that never moves its elements, so that
+	/// references and reads of existing elements stay valid while other threads append.
+	/// Elements are allocated in blocks of geometrically increasing size.
+	class StringStorage
+	{
+	public:
+		StringStorage() = default;
+		~StringStorage() { clear(); }
+		StringStorage(StringStorage const&) = delete;
+		StringStorage& operator=(StringStorage const&) = delete;
+
+		std::string const& at(size_t _index) const;
+		/// Appends a string and returns its index. Not safe to be called concurrently.
+		size_t append(std::string const& _string);
+		size_t size() const { return m_size.load(std::memory_order_acquire); }
+		void clear();
+
+	private:
+		static constexpr size_t firstBlockSize = 64;
+		static constexpr size_t maxBlocks = 48;
+
+		/// @returns the block and the offset in the block of the element at the given index.
+		static std::pair<size_t, size_t> position(size_t _index);
+
+		std::array<std::atomic<std::string*>, maxBlocks> m_blocks{};
+		std::atomic<size_t> m_size{0};
+	};
+
+	struct Shard
+	{
+		std::mutex mutex;
+		StringStorage strings;
+		/// Maps string hashes to indices into ``strings``.
+		std::unordered_multimap<std::uint64_t, size_t> hashToIndex;
+	};
+
+	static constexpr size_t shardBits = 4;
+	static constexpr size_t shardCount = size_t(1) << shardBits;
+
+	YulStringRepository();
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
 
+	/// Clears all shards and re-inserts the empty string, which has ID zero.
+	void clear();
+
+	static std::mutex& resetCallbacksMutex();
 	static std::vector<std::function<void()>>& resetCallbacks()
 	{
 		static std::vector<std::function<void()>> callbacks;
 		return callbacks;
 	}
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	std::array<Shard, shardCount> m_shards;
 };
 
 /// Wrapper around handles into the YulString repository.
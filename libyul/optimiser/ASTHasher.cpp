@@ -0,0 +1,180 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser component that calculates a hash value for a whole AST.
+ */
+
+#include <libyul/optimiser/ASTHasher.h>
+#include <libyul/AST.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+/// Distinguishes the node types, so that for example `x := y` and `let x := y` hash differently.
+enum class NodeTag: uint64_t
+{
+	Literal = 1,
+	Identifier,
+	FunctionCall,
+	ExpressionStatement,
+	Assignment,
+	VariableDeclaration,
+	If,
+	Switch,
+	Case,
+	FunctionDefinition,
+	ForLoop,
+	Break,
+	Continue,
+	Leave,
+	Block
+};
+}
+
+uint64_t ASTHasher::run(Block const& _ast)
+{
+	ASTHasher hasher;
+	hasher(_ast);
+	return hasher.m_hash;
+}
+
+void ASTHasher::operator()(Literal const& _literal)
+{
+	hash64(static_cast<uint64_t>(NodeTag::Literal));
+	hash64(static_cast<uint64_t>(_literal.kind));
+	hash64(_literal.value.hash());
+	hash64(_literal.type.hash());
+}
+
+void ASTHasher::operator()(Identifier const& _identifier)
+{
+	hash64(static_cast<uint64_t>(NodeTag::Identifier));
+	hash64(_identifier.name.hash());
+}
+
+void ASTHasher::operator()(FunctionCall const& _funCall)
+{
+	hash64(static_cast<uint64_t>(NodeTag::FunctionCall));
+	hash64(_funCall.functionName.name.hash());
+	hash64(_funCall.arguments.size());
+	ASTWalker::operator()(_funCall);
+}
+
+void ASTHasher::operator()(ExpressionStatement const& _statement)
+{
+	hash64(static_cast<uint64_t>(NodeTag::ExpressionStatement));
+	ASTWalker::operator()(_statement);
+}
+
+void ASTHasher::operator()(Assignment const& _assignment)
+{
+	hash64(static_cast<uint64_t>(NodeTag::Assignment));
+	hash64(_assignment.variableNames.size());
+	for (auto const& name: _assignment.variableNames)
+		(*this)(name);
+	visit(*_assignment.value);
+}
+
+void ASTHasher::operator()(VariableDeclaration const& _varDecl)
+{
+	hash64(static_cast<uint64_t>(NodeTag::VariableDeclaration));
+	hashTypedNames(_varDecl.variables);
+	hash64(_varDecl.value ? 1 : 0);
+	ASTWalker::operator()(_varDecl);
+}
+
+void ASTHasher::operator()(If const& _if)
+{
+	hash64(static_cast<uint64_t>(NodeTag::If));
+	ASTWalker::operator()(_if);
+}
+
+void ASTHasher::operator()(Switch const& _switch)
+{
+	hash64(static_cast<uint64_t>(NodeTag::Switch));
+	hash64(_switch.cases.size());
+	visit(*_switch.expression);
+	for (auto const& _case: _switch.cases)
+	{
+		hash64(static_cast<uint64_t>(NodeTag::Case));
+		hash64(_case.value ? 1 : 0);
+		if (_case.value)
+			(*this)(*_case.value);
+		(*this)(_case.body);
+	}
+}
+
+void ASTHasher::operator()(FunctionDefinition const& _funDef)
+{
+	hash64(static_cast<uint64_t>(NodeTag::FunctionDefinition));
+	hash64(_funDef.name.hash());
+	hashTypedNames(_funDef.parameters);
+	hashTypedNames(_funDef.returnVariables);
+	ASTWalker::operator()(_funDef);
+}
+
+void ASTHasher::operator()(ForLoop const& _loop)
+{
+	hash64(static_cast<uint64_t>(NodeTag::ForLoop));
+	ASTWalker::operator()(_loop);
+}
+
+void ASTHasher::operator()(Break const&)
+{
+	hash64(static_cast<uint64_t>(NodeTag::Break));
+}
+
+void ASTHasher::operator()(Continue const&)
+{
+	hash64(static_cast<uint64_t>(NodeTag::Continue));
+}
+
+void ASTHasher::operator()(Leave const&)
+{
+	hash64(static_cast<uint64_t>(NodeTag::Leave));
+}
+
+void ASTHasher::operator()(Block const& _block)
+{
+	hash64(static_cast<uint64_t>(NodeTag::Block));
+	hash64(_block.statements.size());
+	ASTWalker::operator()(_block);
+}
+
+void ASTHasher::hash64(uint64_t _value)
+{
+	// FNV-1a on the bytes of the value.
+	for (size_t i = 0; i < 8; ++i)
+	{
+		m_hash ^= (_value >> (8 * i)) & 0xFF;
+		m_hash *= 1099511628211u;
+	}
+}
+
+void ASTHasher::hashTypedNames(vector<TypedName> const& _names)
+{
+	hash64(_names.size());
+	for (TypedName const& name: _names)
+	{
+		hash64(name.name.hash());
+		hash64(name.type.hash());
+	}
+}
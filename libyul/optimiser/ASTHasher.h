@@ -0,0 +1,72 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Optimiser component that calculates a hash value for a whole AST.
+ */
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/ASTForward.h>
+#include <libyul/YulString.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace solidity::yul
+{
+
+/**
+ * Optimiser component that calculates a hash value for a whole AST.
+ * In contrast to BlockHasher, all names and the order of switch cases are
+ * taken into account, so that the hash changes with every modification an
+ * optimiser step can make. Source locations are ignored.
+ *
+ * Prerequisites: None
+ */
+class ASTHasher: public ASTWalker
+{
+public:
+	static uint64_t run(Block const& _ast);
+
+	using ASTWalker::operator();
+
+	void operator()(Literal const& _literal) override;
+	void operator()(Identifier const& _identifier) override;
+	void operator()(FunctionCall const& _funCall) override;
+	void operator()(ExpressionStatement const& _statement) override;
+	void operator()(Assignment const& _assignment) override;
+	void operator()(VariableDeclaration const& _varDecl) override;
+	void operator()(If const& _if) override;
+	void operator()(Switch const& _switch) override;
+	void operator()(FunctionDefinition const& _funDef) override;
+	void operator()(ForLoop const& _loop) override;
+	void operator()(Break const&) override;
+	void operator()(Continue const&) override;
+	void operator()(Leave const&) override;
+	void operator()(Block const& _block) override;
+
+private:
+	ASTHasher() = default;
+
+	void hash64(uint64_t _value);
+	void hashTypedNames(std::vector<TypedName> const& _names);
+
+	uint64_t m_hash = 14695981039346656037u;
+};
+
+}
@@ -47,7 +47,8 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	if (!instruction)
 		return nullptr;
 
-	static std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
+	// The rules store the current match groups, so they cannot be shared between threads.
+	thread_local std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
 
 	std::optional<EVMVersion> version;
 	if (yul::EVMDialect const* evmDialect = dynamic_cast<yul::EVMDialect const*>(&_dialect))
@@ -59,19 +60,46 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	SimplificationRules& rules = *evmRules[version];
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
-	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
+	if (rules.m_rules.empty(instruction->first))
+		return nullptr;
+
+	using Index = SimplificationRuleIndex<Pattern>;
+	rules.m_argumentKinds.clear();
+	for (Expression const& argument: *instruction->second)
+	{
+		// Patterns never match function calls as direct arguments.
+		if (holds_alternative<FunctionCall>(argument))
+			return nullptr;
+		// Resolve the variable like Pattern::matches does for patterns other than "Any".
+		Expression const* value = &argument;
+		if (Identifier const* identifier = get_if<Identifier>(&argument))
+		{
+			auto it = _ssaValues.find(identifier->name);
+			if (it != _ssaValues.end() && it->second.value)
+				value = it->second.value;
+		}
+
+		if (Literal const* literal = get_if<Literal>(value); literal && literal->kind == LiteralKind::Number)
+			rules.m_argumentKinds.push_back(Index::c_constant);
+		else if (auto valueInstruction = instructionAndArguments(_dialect, *value))
+			rules.m_argumentKinds.push_back(Index::operation(valueInstruction->first));
+		else
+			rules.m_argumentKinds.push_back(Index::c_any);
+	}
+
+	for (auto const* rule: rules.m_rules.candidates(instruction->first, rules.m_argumentKinds))
 	{
 		rules.resetMatchGroups();
-		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
-			if (!rule.feasible || rule.feasible())
-				return &rule;
+		if (rule->pattern.matches(_expr, _dialect, _ssaValues))
+			if (!rule->feasible || rule->feasible())
+				return rule;
 	}
 	return nullptr;
 }
 
 bool SimplificationRules::isInitialized() const
 {
-	return !m_rules[uint8_t(evmasm::Instruction::ADD)].empty();
+	return !m_rules.empty(evmasm::Instruction::ADD);
 }
 
 std::optional<std::pair<evmasm::Instruction, vector<Expression> const*>>
@@ -94,7 +122,17 @@ void SimplificationRules::addRules(std::vector<Rule> const& _rules)
 
 void SimplificationRules::addRule(Rule const& _rule)
 {
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	using Index = SimplificationRuleIndex<Pattern>;
+
+	vector<Index::ArgumentKind> argumentKinds;
+	for (Pattern const& argument: _rule.pattern.arguments())
+		if (argument.kind() == PatternKind::Constant)
+			argumentKinds.push_back(Index::c_constant);
+		else if (argument.kind() == PatternKind::Operation)
+			argumentKinds.push_back(Index::operation(argument.instruction()));
+		else
+			argumentKinds.push_back(Index::c_any);
+	m_rules.add(_rule, _rule.pattern.instruction(), move(argumentKinds));
 }
 
 SimplificationRules::SimplificationRules(std::optional<langutil::EVMVersion> _evmVersion)
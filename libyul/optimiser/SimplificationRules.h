@@ -76,7 +76,9 @@ private:
 	void resetMatchGroups() { m_matchGroups.clear(); }
 
 	std::map<unsigned, Expression const*> m_matchGroups;
-	std::vector<evmasm::SimplificationRule<Pattern>> m_rules[256];
+	evmasm::SimplificationRuleIndex<Pattern> m_rules;
+	/// Kinds of the arguments of the expression currently matched, kept to avoid reallocations.
+	std::vector<evmasm::SimplificationRuleIndex<Pattern>::ArgumentKind> m_argumentKinds;
 };
 
 enum class PatternKind
@@ -119,6 +121,7 @@ public:
 		std::map<YulString, AssignedValue> const& _ssaValues
 	) const;
 
+	PatternKind kind() const { return m_kind; }
 	std::vector<Pattern> arguments() const { return m_arguments; }
 
 	/// @returns the data of the matched expression if this pattern is part of a match group.
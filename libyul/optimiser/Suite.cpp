@@ -21,6 +21,7 @@
 
 #include <libyul/optimiser/Suite.h>
 
+#include <libyul/optimiser/ASTHasher.h>
 #include <libyul/optimiser/Disambiguator.h>
 #include <libyul/optimiser/VarDeclInitializer.h>
 #include <libyul/optimiser/BlockFlattener.h>
@@ -86,9 +87,11 @@ void OptimiserSuite::run(
 	Object& _object,
 	bool _optimizeStackAllocation,
 	string const& _optimisationSequence,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	OptimiserSuiteProfile* _profile
 )
 {
+	auto const start = chrono::steady_clock::now();
 	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
 	reservedIdentifiers += _dialect.fixedFunctionNames();
 
@@ -99,7 +102,7 @@ void OptimiserSuite::run(
 	)(*_object.code));
 	Block& ast = *_object.code;
 
-	OptimiserSuite suite(_dialect, reservedIdentifiers, Debug::None, ast);
+	OptimiserSuite suite(_dialect, reservedIdentifiers, Debug::None, ast, _profile);
 
 	// Some steps depend on properties ensured by FunctionHoister, BlockFlattener, FunctionGrouper and
 	// ForLoopInitRewriter. Run them first to be able to run arbitrary sequences safely.
@@ -147,6 +150,43 @@ void OptimiserSuite::run(
 	VarNameCleaner::run(suite.m_context, ast);
 
 	*_object.analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
+
+	if (_profile)
+		_profile->time += chrono::steady_clock::now() - start;
+}
+
+Json::Value OptimiserSuiteProfile::toJson() const
+{
+	auto microseconds = [](chrono::steady_clock::duration _time)
+	{
+		return Json::Int64(chrono::duration_cast<chrono::microseconds>(_time).count());
+	};
+
+	Json::Value output{Json::objectValue};
+	output["time"] = microseconds(time);
+	output["steps"] = Json::objectValue;
+	for (auto const& [abbreviation, statistics]: steps)
+	{
+		Json::Value& step = output["steps"][string(1, abbreviation)];
+		step["name"] = OptimiserSuite::stepAbbreviationToNameMap().at(abbreviation);
+		step["invocations"] = Json::UInt64(statistics.invocations);
+		step["skipped"] = Json::UInt64(statistics.skipped);
+		step["time"] = microseconds(statistics.time);
+		step["codeSizeBefore"] = Json::UInt64(statistics.codeSizeBefore);
+		step["codeSizeAfter"] = Json::UInt64(statistics.codeSizeAfter);
+	}
+	output["fixpointIterations"] = Json::arrayValue;
+	for (FixpointIteration const& iteration: fixpointIterations)
+	{
+		Json::Value entry{Json::objectValue};
+		entry["steps"] = iteration.steps;
+		entry["iteration"] = Json::UInt64(iteration.iteration);
+		entry["time"] = microseconds(iteration.time);
+		entry["codeSizeBefore"] = Json::UInt64(iteration.codeSizeBefore);
+		entry["codeSizeAfter"] = Json::UInt64(iteration.codeSizeAfter);
+		output["fixpointIterations"].append(move(entry));
+	}
+	return output;
 }
 
 namespace
@@ -171,40 +211,38 @@ map<string, unique_ptr<OptimiserStep>> optimiserStepCollection()
 
 map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static map<string, unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
-			BlockFlattener,
-			CircularReferencesPruner,
-			CommonSubexpressionEliminator,
-			ConditionalSimplifier,
-			ConditionalUnsimplifier,
-			ControlFlowSimplifier,
-			DeadCodeEliminator,
-			EquivalentFunctionCombiner,
-			ExpressionInliner,
-			ExpressionJoiner,
-			ExpressionSimplifier,
-			ExpressionSplitter,
-			ForLoopConditionIntoBody,
-			ForLoopConditionOutOfBody,
-			ForLoopInitRewriter,
-			FullInliner,
-			FunctionGrouper,
-			FunctionHoister,
-			LiteralRematerialiser,
-			LoadResolver,
-			LoopInvariantCodeMotion,
-			RedundantAssignEliminator,
-			ReasoningBasedSimplifier,
-			Rematerialiser,
-			SSAReverser,
-			SSATransform,
-			StructuralSimplifier,
-			UnusedFunctionParameterPruner,
-			UnusedPruner,
-			VarDeclInitializer
-		>();
+	static map<string, unique_ptr<OptimiserStep>> const instance = optimiserStepCollection<
+		BlockFlattener,
+		CircularReferencesPruner,
+		CommonSubexpressionEliminator,
+		ConditionalSimplifier,
+		ConditionalUnsimplifier,
+		ControlFlowSimplifier,
+		DeadCodeEliminator,
+		EquivalentFunctionCombiner,
+		ExpressionInliner,
+		ExpressionJoiner,
+		ExpressionSimplifier,
+		ExpressionSplitter,
+		ForLoopConditionIntoBody,
+		ForLoopConditionOutOfBody,
+		ForLoopInitRewriter,
+		FullInliner,
+		FunctionGrouper,
+		FunctionHoister,
+		LiteralRematerialiser,
+		LoadResolver,
+		LoopInvariantCodeMotion,
+		RedundantAssignEliminator,
+		ReasoningBasedSimplifier,
+		Rematerialiser,
+		SSAReverser,
+		SSATransform,
+		StructuralSimplifier,
+		UnusedFunctionParameterPruner,
+		UnusedPruner,
+		VarDeclInitializer
+	>();
 	// Does not include VarNameCleaner because it destroys the property of unique names.
 	// Does not include NameSimplifier.
 	return instance;
@@ -341,11 +379,39 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 	unique_ptr<Block> copy;
 	if (m_debug == Debug::PrintChanges)
 		copy = make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
+	uint64_t astHash = ASTHasher::run(_ast);
 	for (string const& step: _steps)
 	{
+		// Steps are deterministic, so running a step again on an AST it did not change before
+		// cannot have any effect.
+		auto unchanged = m_unchangedASTs.find(step);
+		if (unchanged != m_unchangedASTs.end() && unchanged->second == astHash)
+		{
+			if (m_profile)
+				++m_profile->steps[stepNameToAbbreviationMap().at(step)].skipped;
+			continue;
+		}
+
 		if (m_debug == Debug::PrintStep)
 			cout << "Running " << step << endl;
-		allSteps().at(step)->run(m_context, _ast);
+		if (m_profile)
+		{
+			OptimiserSuiteProfile::StepStatistics& statistics = m_profile->steps[stepNameToAbbreviationMap().at(step)];
+			statistics.codeSizeBefore += CodeSize::codeSizeIncludingFunctions(_ast);
+			auto const start = chrono::steady_clock::now();
+			allSteps().at(step)->run(m_context, _ast);
+			statistics.time += chrono::steady_clock::now() - start;
+			statistics.codeSizeAfter += CodeSize::codeSizeIncludingFunctions(_ast);
+			++statistics.invocations;
+		}
+		else
+			allSteps().at(step)->run(m_context, _ast);
+
+		uint64_t newHash = ASTHasher::run(_ast);
+		if (newHash == astHash)
+			m_unchangedASTs[step] = astHash;
+		astHash = newHash;
+
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
@@ -378,6 +444,18 @@ void OptimiserSuite::runSequenceUntilStable(
 			break;
 		codeSize = newSize;
 
+		auto const start = chrono::steady_clock::now();
 		runSequence(_steps, _ast);
+		if (m_profile)
+		{
+			OptimiserSuiteProfile::FixpointIteration iteration;
+			for (string const& step: _steps)
+				iteration.steps += stepNameToAbbreviationMap().at(step);
+			iteration.iteration = rounds;
+			iteration.time = chrono::steady_clock::now() - start;
+			iteration.codeSizeBefore = codeSize;
+			iteration.codeSizeAfter = CodeSize::codeSizeIncludingFunctions(_ast);
+			m_profile->fixpointIterations.emplace_back(move(iteration));
+		}
 	}
 }
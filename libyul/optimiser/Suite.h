@@ -27,9 +27,14 @@
 #include <libyul/optimiser/NameDispenser.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <json/json.h>
+
+#include <chrono>
+#include <map>
 #include <set>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace solidity::yul
 {
@@ -39,6 +44,42 @@ struct Dialect;
 class GasMeter;
 struct Object;
 
+/**
+ * Wall time and code size statistics collected while running the optimiser suite
+ * on a single object. Code sizes are measured with CodeSize::codeSizeIncludingFunctions.
+ */
+struct OptimiserSuiteProfile
+{
+	struct StepStatistics
+	{
+		size_t invocations = 0;
+		/// Number of times the step was not run because it would not have changed the AST.
+		size_t skipped = 0;
+		std::chrono::steady_clock::duration time{};
+		/// Sums of the code sizes before and after the invocations.
+		size_t codeSizeBefore = 0;
+		size_t codeSizeAfter = 0;
+	};
+	/// A single run of the steps inside brackets while repeating them until the code size is stable.
+	struct FixpointIteration
+	{
+		std::string steps;
+		size_t iteration = 0;
+		std::chrono::steady_clock::duration time{};
+		size_t codeSizeBefore = 0;
+		size_t codeSizeAfter = 0;
+	};
+
+	/// Time spent in the whole suite, including the parts that are not optimiser steps.
+	std::chrono::steady_clock::duration time{};
+	/// Statistics per step abbreviation.
+	std::map<char, StepStatistics> steps;
+	std::vector<FixpointIteration> fixpointIterations;
+
+	/// @returns the statistics in JSON format, times are given in microseconds.
+	Json::Value toJson() const;
+};
+
 /**
  * Optimiser suite that combines all steps and also provides the settings for the heuristics.
  * Only optimizes the code of the provided object, does not descend into the sub-objects.
@@ -64,7 +105,8 @@ public:
 		Object& _object,
 		bool _optimizeStackAllocation,
 		std::string const& _optimisationSequence,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		OptimiserSuiteProfile* _profile = nullptr
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
@@ -88,16 +130,22 @@ private:
 		Dialect const& _dialect,
 		std::set<YulString> const& _externallyUsedIdentifiers,
 		Debug _debug,
-		Block& _ast
+		Block& _ast,
+		OptimiserSuiteProfile* _profile = nullptr
 	):
 		m_dispenser{_dialect, _ast, _externallyUsedIdentifiers},
 		m_context{_dialect, m_dispenser, _externallyUsedIdentifiers},
-		m_debug(_debug)
+		m_debug(_debug),
+		m_profile(_profile)
 	{}
 
 	NameDispenser m_dispenser;
 	OptimiserStepContext m_context;
 	Debug m_debug;
+	/// Receives the statistics of the steps that are run, if not null.
+	OptimiserSuiteProfile* m_profile = nullptr;
+	/// For each step, the hash (see ASTHasher) of the last AST the step was run on without modifying it.
+	std::map<std::string, uint64_t> m_unchangedASTs;
 };
 
 }
@@ -31,6 +31,7 @@
 #include <libsolidity/ast/ASTJsonConverter.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/GasEstimator.h>
@@ -48,6 +49,7 @@
 #include <liblangutil/SourceReferenceFormatter.h>
 
 #include <libsmtutil/Exceptions.h>
+#include <libsmtutil/QueryCache.h>
 
 #include <libsolutil/Common.h>
 #include <libsolutil/CommonData.h>
@@ -136,6 +138,7 @@ static string const g_strExperimentalViaIR = "experimental-via-ir";
 static string const g_strGeneratedSources = "generated-sources";
 static string const g_strGeneratedSourcesRuntime = "generated-sources-runtime";
 static string const g_strGas = "gas";
+static string const g_strGasMaxSteps = "gas-max-steps";
 static string const g_strHelp = "help";
 static string const g_strImportAst = "import-ast";
 static string const g_strInputFile = "input-file";
@@ -155,6 +158,8 @@ static string const g_strMetadataLiteral = "metadata-literal";
 static string const g_strModelCheckerEngine = "model-checker-engine";
 static string const g_strModelCheckerTargets = "model-checker-targets";
 static string const g_strModelCheckerTimeout = "model-checker-timeout";
+static string const g_strModelCheckerRaceSolvers = "model-checker-race-solvers";
+static string const g_strModelCheckerCacheDir = "model-checker-cache-dir";
 static string const g_strNatspecDev = "devdoc";
 static string const g_strNatspecUser = "userdoc";
 static string const g_strNone = "none";
@@ -164,11 +169,14 @@ static string const g_strOptimize = "optimize";
 static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOptimizeYul = "optimize-yul";
 static string const g_strYulOptimizations = "yul-optimizations";
+static string const g_strYulOptimizerProfile = "yul-optimizer-profile";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
 static string const g_strRevertStrings = "revert-strings";
 static string const g_strStorageLayout = "storage-layout";
 static string const g_strStopAfter = "stop-after";
+static string const g_strThreads = "threads";
+static string const g_strCacheDir = "cache-dir";
 static string const g_strParsing = "parsing";
 
 /// Possible arguments to for --revert-strings
@@ -210,6 +218,7 @@ static string const g_argCombinedJson = g_strCombinedJson;
 static string const g_argCompactJSON = g_strCompactJSON;
 static string const g_argErrorRecovery = g_strErrorRecovery;
 static string const g_argGas = g_strGas;
+static string const g_argGasMaxSteps = g_strGasMaxSteps;
 static string const g_argHelp = g_strHelp;
 static string const g_argImportAst = g_strImportAst;
 static string const g_argInputFile = g_strInputFile;
@@ -227,6 +236,8 @@ static string const g_argMetadataLiteral = g_strMetadataLiteral;
 static string const g_argModelCheckerEngine = g_strModelCheckerEngine;
 static string const g_argModelCheckerTargets = g_strModelCheckerTargets;
 static string const g_argModelCheckerTimeout = g_strModelCheckerTimeout;
+static string const g_argModelCheckerRaceSolvers = g_strModelCheckerRaceSolvers;
+static string const g_argModelCheckerCacheDir = g_strModelCheckerCacheDir;
 static string const g_argNatspecDev = g_strNatspecDev;
 static string const g_argNatspecUser = g_strNatspecUser;
 static string const g_argOpcodes = g_strOpcodes;
@@ -236,6 +247,7 @@ static string const g_argOutputDir = g_strOutputDir;
 static string const g_argSignatureHashes = g_strSignatureHashes;
 static string const g_argStandardJSON = g_strStandardJSON;
 static string const g_argStorageLayout = g_strStorageLayout;
+static string const g_argYulOptimizerProfile = g_strYulOptimizerProfile;
 static string const g_argStrictAssembly = g_strStrictAssembly;
 static string const g_argVersion = g_strVersion;
 static string const g_stdinFileName = g_stdinFileNameStr;
@@ -413,6 +425,21 @@ void CommandLineInterface::handleIROptimized(string const& _contractName)
 	}
 }
 
+void CommandLineInterface::handleYulOptimizerProfile(string const& _contractName)
+{
+	if (!m_args.count(g_argYulOptimizerProfile))
+		return;
+
+	string profile = jsonPrettyPrint(m_compiler->yulOptimizerProfile(_contractName));
+	if (m_args.count(g_argOutputDir))
+		createFile(m_compiler->filesystemFriendlyName(_contractName) + "_yul_profile.json", profile);
+	else
+	{
+		sout() << "Yul optimizer profile:" << endl;
+		sout() << profile << endl;
+	}
+}
+
 void CommandLineInterface::handleEwasm(string const& _contractName)
 {
 	if (!m_args.count(g_argEwasm))
@@ -536,7 +563,10 @@ void CommandLineInterface::handleNatspec(bool _natspecDev, string const& _contra
 
 void CommandLineInterface::handleGasEstimation(string const& _contract)
 {
-	Json::Value estimates = m_compiler->gasEstimates(_contract);
+	optional<size_t> maxSteps;
+	if (m_args.count(g_argGasMaxSteps))
+		maxSteps = m_args[g_argGasMaxSteps].as<unsigned>();
+	Json::Value estimates = m_compiler->gasEstimates(_contract, maxSteps);
 	sout() << "Gas estimation:" << endl;
 
 	if (estimates["creation"].isObject())
@@ -882,6 +912,19 @@ General Information)").c_str(),
 			po::value<string>()->value_name("stage"),
 			"Stop execution after the given compiler stage. Valid options: \"parsing\"."
 		)
+		(
+			g_strThreads.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Use up to n threads to parse sources, to compile independent contracts and Yul objects "
+			"and to check the verification targets of the BMC model checker engine concurrently."
+		)
+		(
+			g_strCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			("Store compilation results in the given directory and reuse them for contracts "
+			"compiled again with the same sources and settings. "
+			"Only supported together with --" + g_argStandardJSON + ".").c_str()
+		)
 	;
 	desc.add(outputOptions);
 
@@ -984,6 +1027,11 @@ General Information)").c_str(),
 		(g_argAbi.c_str(), "ABI specification of the contracts.")
 		(g_argIR.c_str(), "Intermediate Representation (IR) of all contracts (EXPERIMENTAL).")
 		(g_argIROptimized.c_str(), "Optimized intermediate Representation (IR) of all contracts (EXPERIMENTAL).")
+		(
+			g_argYulOptimizerProfile.c_str(),
+			"Time spent in the Yul optimizer steps and their effect on the code size for all contracts "
+			"or the assembly input, in JSON format (EXPERIMENTAL)."
+		)
 		(g_argEwasm.c_str(), "Ewasm text representation of all contracts (EXPERIMENTAL).")
 		(g_argSignatureHashes.c_str(), "Function signature hashes of the contracts.")
 		(g_argNatspecUser.c_str(), "Natspec user documentation of all contracts.")
@@ -999,6 +1047,12 @@ General Information)").c_str(),
 			g_argGas.c_str(),
 			"Print an estimate of the maximal gas usage for each function."
 		)
+		(
+			g_argGasMaxSteps.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Explore at most n assembly items per gas estimate, estimates that exceed it are infinite. "
+			"The default is 100000."
+		)
 		(
 			g_argCombinedJson.c_str(),
 			po::value<string>()->value_name(boost::join(g_combinedJsonArgs, ",")),
@@ -1070,6 +1124,17 @@ General Information)").c_str(),
 			"The default is a deterministic resource limit. "
 			"A timeout of 0 means no resource/time restrictions for any query."
 		)
+		(
+			g_strModelCheckerRaceSolvers.c_str(),
+			"Run the SMT solvers of the BMC engine concurrently and use the first answer, "
+			"instead of querying them one after another and reporting conflicting answers (experimental)."
+		)
+		(
+			g_strModelCheckerCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			("Store the answers of the SMT solvers Z3 and CVC4 in the given directory and reuse them "
+			"for identical queries in later runs. Also supported together with --" + g_argStandardJSON + ".").c_str()
+		)
 	;
 	desc.add(smtCheckerOptions);
 
@@ -1101,6 +1166,7 @@ General Information)").c_str(),
 		g_argBinary,
 		g_argIR,
 		g_argIROptimized,
+		g_argYulOptimizerProfile,
 		g_argEwasm,
 		g_argGas,
 		g_argAsm,
@@ -1275,6 +1341,12 @@ bool CommandLineInterface::processInput()
 		return false;
 	}
 
+	if (m_args.count(g_strCacheDir) && !m_args.count(g_argStandardJSON))
+	{
+		serr() << "Option --" << g_strCacheDir << " is only supported together with --" << g_argStandardJSON << "." << endl;
+		return false;
+	}
+
 	if (m_args.count(g_argStandardJSON))
 	{
 		vector<string> inputFiles;
@@ -1303,7 +1375,13 @@ bool CommandLineInterface::processInput()
 				return false;
 			}
 		}
-		StandardCompiler compiler(fileReader);
+		shared_ptr<CompilationCache> compilationCache;
+		if (m_args.count(g_strCacheDir))
+			compilationCache = make_shared<CompilationCache>(m_args[g_strCacheDir].as<string>());
+		shared_ptr<smtutil::QueryCache> smtQueryCache;
+		if (m_args.count(g_argModelCheckerCacheDir))
+			smtQueryCache = make_shared<smtutil::QueryCache>(m_args[g_argModelCheckerCacheDir].as<string>());
+		StandardCompiler compiler(fileReader, compilationCache, smtQueryCache);
 		sout() << compiler.compile(std::move(input)) << endl;
 		return true;
 	}
@@ -1328,6 +1406,18 @@ bool CommandLineInterface::processInput()
 		m_evmVersion = *versionOption;
 	}
 
+	if (m_args.count(g_strThreads) && m_args[g_strThreads].as<unsigned>() == 0)
+	{
+		serr() << "Invalid option for --" << g_strThreads << ": At least one thread is required." << endl;
+		return false;
+	}
+
+	if (m_args.count(g_argGasMaxSteps) && m_args[g_argGasMaxSteps].as<unsigned>() == 0)
+	{
+		serr() << "Invalid option for --" << g_argGasMaxSteps << ": At least one step is required." << endl;
+		return false;
+	}
+
 	if (m_args.count(g_argAssemble) || m_args.count(g_argStrictAssembly) || m_args.count(g_argYul))
 	{
 		vector<string> const nonAssemblyModeOptions = {
@@ -1497,6 +1587,12 @@ bool CommandLineInterface::processInput()
 	if (m_args.count(g_argModelCheckerTimeout))
 		m_modelCheckerSettings.timeout = m_args[g_argModelCheckerTimeout].as<unsigned>();
 
+	if (m_args.count(g_argModelCheckerRaceSolvers))
+		m_modelCheckerSettings.raceSolvers = true;
+
+	if (m_args.count(g_argModelCheckerCacheDir))
+		m_modelCheckerSettings.queryCache = make_shared<smtutil::QueryCache>(m_args[g_argModelCheckerCacheDir].as<string>());
+
 	m_compiler = make_unique<CompilerStack>(fileReader);
 
 	SourceReferenceFormatter formatter(serr(false), m_coloredOutput, m_withErrorIds);
@@ -1507,7 +1603,12 @@ bool CommandLineInterface::processInput()
 			m_compiler->useMetadataLiteralSources(true);
 		if (m_args.count(g_argMetadataHash))
 			m_compiler->setMetadataHash(m_metadataHash);
-		if (m_args.count(g_argModelCheckerEngine) || m_args.count(g_argModelCheckerTimeout))
+		if (
+			m_args.count(g_argModelCheckerEngine) ||
+			m_args.count(g_argModelCheckerTimeout) ||
+			m_args.count(g_argModelCheckerRaceSolvers) ||
+			m_args.count(g_argModelCheckerCacheDir)
+		)
 			m_compiler->setModelCheckerSettings(m_modelCheckerSettings);
 		if (m_args.count(g_argInputFile))
 			m_compiler->setRemappings(m_remappings);
@@ -1516,11 +1617,18 @@ bool CommandLineInterface::processInput()
 			m_compiler->setLibraries(m_libraries);
 		if (m_args.count(g_argExperimentalViaIR))
 			m_compiler->setViaIR(true);
+		if (m_args.count(g_strThreads))
+			m_compiler->setThreadCount(m_args[g_strThreads].as<unsigned>());
 		m_compiler->setEVMVersion(m_evmVersion);
 		m_compiler->setRevertStringBehaviour(m_revertStrings);
 		// TODO: Perhaps we should not compile unless requested
 
-		m_compiler->enableIRGeneration(m_args.count(g_argIR) || m_args.count(g_argIROptimized));
+		m_compiler->enableIRGeneration(
+			m_args.count(g_argIR) ||
+			m_args.count(g_argIROptimized) ||
+			m_args.count(g_argYulOptimizerProfile)
+		);
+		m_compiler->enableYulOptimizerProfile(m_args.count(g_argYulOptimizerProfile));
 		m_compiler->enableEwasmGeneration(m_args.count(g_argEwasm));
 
 		OptimiserSettings settings = m_args.count(g_argOptimize) ? OptimiserSettings::standard() : OptimiserSettings::minimal();
@@ -1894,6 +2002,9 @@ bool CommandLineInterface::assemble(
 			settings.yulOptimiserSteps = _yulOptimiserSteps.value();
 
 		auto& stack = assemblyStacks[src.first] = yul::AssemblyStack(m_evmVersion, _language, settings);
+		if (m_args.count(g_strThreads))
+			stack.setThreadCount(m_args[g_strThreads].as<unsigned>());
+		stack.enableOptimiserProfile(m_args.count(g_argYulOptimizerProfile));
 		try
 		{
 			if (!stack.parseAndAnalyze(src.first, src.second))
@@ -2017,6 +2128,12 @@ bool CommandLineInterface::assemble(
 			sout() << object.assembly << endl;
 		else
 			serr() << "No text representation found." << endl;
+
+		if (m_args.count(g_argYulOptimizerProfile))
+		{
+			sout() << endl << "Yul optimizer profile:" << endl;
+			sout() << jsonPrettyPrint(stack.optimiserProfile()) << endl;
+		}
 	}
 
 	return true;
@@ -2069,6 +2186,7 @@ void CommandLineInterface::outputCompilationResults()
 		handleBytecode(contract);
 		handleIR(contract);
 		handleIROptimized(contract);
+		handleYulOptimizerProfile(contract);
 		handleEwasm(contract);
 		handleSignatureHashes(contract);
 		handleMetadata(contract);
@@ -0,0 +1,27 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+
+contract C {
+	uint data;
+	function f(uint x) public {
+		data = g(x) + g(x + 1);
+	}
+	function h(uint x) public {
+		data = x;
+	}
+	function g(uint x) internal pure returns (uint) {
+		return x * 2;
+	}
+}
+
+contract D {
+	uint data;
+	function f(uint x) public {
+		data = g(x);
+	}
+	function g(uint x) internal returns (uint) {
+		if (x == 0)
+			return data;
+		return g(x - 1) + 1;
+	}
+}
@@ -0,0 +1,13 @@
+// SPDX-License-Identifier: GPL-3.0
+pragma solidity >=0.0;
+
+contract C {}
+contract D {
+    function f() public returns (C) { return new C(); }
+}
+contract E {
+    function f() public returns (C) { return new C(); }
+}
+contract F {
+    function f() public pure returns (uint) { return 7; }
+}
@@ -280,6 +280,91 @@ BOOST_AUTO_TEST_CASE(subobject_encode_decode)
 	BOOST_CHECK(assembly.decodeSubPath(assembly.encodeSubPath(subPath)) == subPath);
 }
 
+BOOST_AUTO_TEST_CASE(item_data)
+{
+	u256 const large = u256(1) << 200;
+	vector<u256> values{0, 1, u256(numeric_limits<uint64_t>::max()), u256(numeric_limits<uint64_t>::max()) + 1, large, large + 1};
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		AssemblyItem item(values[i]);
+		BOOST_CHECK_EQUAL(item.data(), values[i]);
+		BOOST_CHECK(item == AssemblyItem(values[i]));
+		for (size_t j = 0; j < values.size(); ++j)
+		{
+			BOOST_CHECK_EQUAL(item == AssemblyItem(values[j]), i == j);
+			BOOST_CHECK_EQUAL(item < AssemblyItem(values[j]), i < j);
+		}
+	}
+
+	AssemblyItem tag(PushTag, 7);
+	tag.setPushTagSubIdAndTag(3, 7);
+	BOOST_CHECK(tag.splitForeignPushTag() == make_pair(size_t(3), size_t(7)));
+	tag.setData(1);
+	BOOST_CHECK_EQUAL(tag.data(), 1);
+	BOOST_CHECK(!tag.pushedValue());
+	tag.setPushedValue(large);
+	BOOST_CHECK(tag.pushedValue() && *tag.pushedValue() == large);
+}
+
+BOOST_AUTO_TEST_CASE(optimise_subs_concurrently)
+{
+	// Creates an assembly with a block that is a duplicate of the one at the returned tag.
+	auto createSub = [](u256 const& _value, shared_ptr<Assembly> const& _sub)
+	{
+		auto assembly = make_shared<Assembly>();
+		AssemblyItem first = assembly->newTag();
+		AssemblyItem second = assembly->newTag();
+		assembly->append(u256(1));
+		assembly->append(Instruction::POP);
+		assembly->append(Instruction::CALLDATASIZE);
+		assembly->appendJumpI(first);
+		assembly->appendJump(second);
+		for (AssemblyItem const& tag: {first, second})
+		{
+			assembly->append(tag);
+			assembly->append(_value);
+			assembly->append(u256(0));
+			assembly->append(Instruction::SSTORE);
+			assembly->append(Instruction::STOP);
+		}
+		if (_sub)
+			assembly->appendSubroutine(_sub);
+		return make_pair(assembly, second);
+	};
+	auto optimisedAssembly = [&](size_t _threadCount)
+	{
+		auto shared = createSub(7, nullptr).first;
+		Assembly assembly;
+		for (u256 value: {1, 2, 3, 4, 5})
+		{
+			auto [sub, tag] = createSub(value, value % 2 ? shared : nullptr);
+			AssemblyItem pushTag = tag.pushTag();
+			pushTag.setPushTagSubIdAndTag(assembly.numSubs(), static_cast<size_t>(tag.data()));
+			assembly.appendSubroutine(sub);
+			assembly.append(pushTag);
+		}
+		assembly.append(Instruction::STOP);
+
+		Assembly::OptimiserSettings settings;
+		settings.isCreation = true;
+		settings.runJumpdestRemover = true;
+		settings.runPeephole = true;
+		settings.runDeduplicate = true;
+		settings.runCSE = true;
+		settings.runConstantOptimiser = true;
+		settings.threadCount = _threadCount;
+		assembly.optimise(settings);
+		return make_pair(assembly.assemblyString(), shared->assemblyString());
+	};
+
+	auto sequential = optimisedAssembly(1);
+	// The duplicate block of each sub was removed and the foreign push tag replaced.
+	BOOST_CHECK(sequential.first.find("tag_0_1") != string::npos);
+	BOOST_CHECK(sequential.first.find("tag_0_2") == string::npos);
+	for (size_t threadCount: {2, 4, 8})
+		BOOST_CHECK(optimisedAssembly(threadCount) == sequential);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -931,6 +931,45 @@ BOOST_AUTO_TEST_CASE(block_deduplicator_loops)
 	BOOST_CHECK_EQUAL(pushTags.size(), 1);
 }
 
+BOOST_AUTO_TEST_CASE(block_deduplicator_successors)
+{
+	// Blocks 1 and 2 only have the same content after blocks 3 and 4 were unified.
+	AssemblyItems input{
+		AssemblyItem(PushTag, 1),
+		AssemblyItem(PushTag, 2),
+		AssemblyItem(PushTag, 3),
+		AssemblyItem(PushTag, 4),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 1),
+		u256(1),
+		AssemblyItem(PushTag, 3),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 2),
+		u256(1),
+		AssemblyItem(PushTag, 4),
+		Instruction::JUMP,
+		AssemblyItem(Tag, 3),
+		u256(7),
+		u256(8),
+		Instruction::SSTORE,
+		Instruction::STOP,
+		AssemblyItem(Tag, 4),
+		u256(7),
+		u256(8),
+		Instruction::SSTORE,
+		Instruction::STOP
+	};
+	BlockDeduplicator deduplicator(input);
+	BOOST_CHECK(deduplicator.deduplicate());
+
+	set<u256> pushTags;
+	for (AssemblyItem const& item: input)
+		if (item.type() == PushTag)
+			pushTags.insert(item.data());
+	BOOST_CHECK(pushTags == set<u256>({1, 3}));
+	BOOST_CHECK(deduplicator.replacedTags() == (map<u256, u256>{{2, 1}, {4, 3}}));
+}
+
 BOOST_AUTO_TEST_CASE(clear_unreachable_code)
 {
 	AssemblyItems items{
@@ -1000,8 +1039,22 @@ BOOST_AUTO_TEST_CASE(peephole_pop_calldatasize)
 		Instruction::POP
 	};
 	PeepholeOptimiser peepOpt(items);
-	for (size_t i = 0; i < 3; i++)
-		BOOST_CHECK(peepOpt.optimise());
+	BOOST_CHECK(peepOpt.optimise());
+	BOOST_CHECK(items.empty());
+	BOOST_CHECK(!peepOpt.optimise());
+}
+
+BOOST_AUTO_TEST_CASE(peephole_nested_push_pop)
+{
+	AssemblyItems items;
+	for (size_t i = 0; i < 1000; i++)
+		items.emplace_back(u256(i));
+	items.emplace_back(Instruction::CALLDATASIZE);
+	items.emplace_back(Instruction::ISZERO);
+	for (size_t i = 0; i < 1001; i++)
+		items.emplace_back(Instruction::POP);
+	PeepholeOptimiser peepOpt(items);
+	BOOST_CHECK(peepOpt.optimise());
 	BOOST_CHECK(items.empty());
 }
 
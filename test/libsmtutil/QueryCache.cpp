@@ -0,0 +1,105 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsmtutil/QueryCache.h>
+#include <libsmtutil/SMTPortfolio.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+namespace fs = boost::filesystem;
+
+namespace solidity::smtutil::test
+{
+
+BOOST_AUTO_TEST_SUITE(SMTQueryCache)
+
+BOOST_AUTO_TEST_CASE(store_and_load)
+{
+	fs::path directory = fs::temp_directory_path() / fs::unique_path("solidity-smt-query-cache-%%%%-%%%%-%%%%");
+	QueryCache cache(directory);
+
+	auto satKey = QueryCache::key("z3", "(check-sat)\n");
+	auto unsatKey = QueryCache::key("cvc4", "(check-sat)\n");
+	BOOST_CHECK(satKey != unsatKey);
+	BOOST_CHECK(!cache.load(satKey));
+
+	cache.store(satKey, CheckResult::SATISFIABLE, {"0", "", "true"});
+	cache.store(unsatKey, CheckResult::UNSATISFIABLE, {});
+	auto sat = cache.load(satKey);
+	BOOST_REQUIRE(sat);
+	BOOST_CHECK(sat->first == CheckResult::SATISFIABLE);
+	BOOST_CHECK(sat->second == vector<string>({"0", "", "true"}));
+	auto unsat = cache.load(unsatKey);
+	BOOST_REQUIRE(unsat);
+	BOOST_CHECK(unsat->first == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK(unsat->second.empty());
+
+	// Results that are not answers are not stored.
+	auto unknownKey = QueryCache::key("z3", "(check-sat)\n(get-value (|x|))\n");
+	cache.store(unknownKey, CheckResult::UNKNOWN, {});
+	BOOST_CHECK(!cache.load(unknownKey));
+	BOOST_CHECK_EQUAL(distance(fs::directory_iterator(directory), fs::directory_iterator()), 2);
+
+	// Invalid entries are ignored.
+	for (auto const& entry: fs::directory_iterator(directory))
+		fs::ofstream(entry.path(), ios::trunc) << "sat";
+	BOOST_CHECK(!cache.load(satKey));
+	BOOST_CHECK(!cache.load(unsatKey));
+
+	fs::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_CASE(portfolio_queries_smtlib2_on_hit)
+{
+	fs::path directory = fs::temp_directory_path() / fs::unique_path("solidity-smt-query-cache-%%%%-%%%%-%%%%");
+	auto cache = make_shared<QueryCache>(directory);
+
+	size_t callbackCalls = 0;
+	frontend::ReadCallback::Callback callback = [&](string const&, string const&) {
+		++callbackCalls;
+		return frontend::ReadCallback::Result{false, "No solver."};
+	};
+	auto query = [&]() {
+		SMTPortfolio solver({}, callback, SMTSolverChoice::All(), nullopt, false, cache);
+		Expression x = solver.newVariable("x", SortProvider::sintSort);
+		solver.addAssertion(x > 2);
+		auto result = solver.check({x});
+		return make_pair(result.first, solver.unhandledQueries());
+	};
+
+	// The second query is answered from the cache if an in-process solver is available.
+	auto [coldResult, coldQueries] = query();
+	auto [warmResult, warmQueries] = query();
+	BOOST_CHECK(warmResult == coldResult);
+	BOOST_CHECK_EQUAL(warmQueries.size(), 1);
+	BOOST_CHECK(warmQueries == coldQueries);
+	BOOST_CHECK_EQUAL(callbackCalls, 2);
+
+	fs::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
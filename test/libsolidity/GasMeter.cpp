@@ -195,6 +195,74 @@ BOOST_AUTO_TEST_CASE(function_calls)
 	testRunTimeGas("f(uint256)", vector<bytes>{encodeArgs(2), encodeArgs(8)});
 }
 
+BOOST_AUTO_TEST_CASE(repeated_function_calls)
+{
+	char const* sourceCode = R"(
+		contract test {
+			uint data;
+			function f(uint x) public {
+				data = g(x) + g(x + 1);
+			}
+			function g(uint x) internal pure returns (uint) {
+				return x * 2;
+			}
+		}
+	)";
+	testCreationTimeGas(sourceCode);
+	testRunTimeGas("f(uint256)", vector<bytes>{encodeArgs(2), encodeArgs(8)});
+}
+
+BOOST_AUTO_TEST_CASE(exploration_budget)
+{
+	char const* sourceCode = R"(
+		contract test {
+			uint data;
+			function f(uint x) public {
+				data = g(x) + g(x + 1);
+			}
+			function g(uint x) internal pure returns (uint) {
+				return x * 2;
+			}
+		}
+	)";
+	compile(sourceCode);
+	auto const evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	evmasm::AssemblyItems const& items = *m_compiler.runtimeAssemblyItems(m_compiler.lastContractName());
+	BOOST_CHECK(!GasEstimator(evmVersion).functionalEstimation(items, "f(uint256)").isInfinite);
+	BOOST_CHECK(GasEstimator(evmVersion, 10).functionalEstimation(items, "f(uint256)").isInfinite);
+
+	Json::Value estimates = m_compiler.gasEstimates(m_compiler.lastContractName());
+	BOOST_CHECK(estimates["external"]["f(uint256)"].asString() != "infinite");
+	estimates = m_compiler.gasEstimates(m_compiler.lastContractName(), 10);
+	BOOST_CHECK_EQUAL(estimates["external"]["f(uint256)"].asString(), "infinite");
+}
+
+BOOST_AUTO_TEST_CASE(recursive_function)
+{
+	char const* sourceCode = R"(
+		contract test {
+			uint data;
+			function f(uint x) public {
+				data = g(x);
+			}
+			function h(uint x) public {
+				data = x;
+			}
+			function g(uint x) internal returns (uint) {
+				if (x == 0)
+					return data;
+				return g(x - 1) + 1;
+			}
+		}
+	)";
+	compile(sourceCode);
+	auto const evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	evmasm::AssemblyItems const& items = *m_compiler.runtimeAssemblyItems(m_compiler.lastContractName());
+	// Recursion cannot be bounded, but does not affect functions that do not recurse.
+	BOOST_CHECK(GasEstimator(evmVersion).functionalEstimation(items, "f(uint256)").isInfinite);
+	BOOST_CHECK(!GasEstimator(evmVersion).functionalEstimation(items, "h(uint256)").isInfinite);
+}
+
 BOOST_AUTO_TEST_CASE(multiple_external_functions)
 {
 	char const* sourceCode = R"(
@@ -26,6 +26,8 @@
 
 #include <liblangutil/Exceptions.h>
 #include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/ast/ASTJsonConverter.h>
+#include <libsolutil/JSON.h>
 
 #include <boost/test/unit_test.hpp>
 
@@ -112,6 +114,104 @@ BOOST_AUTO_TEST_CASE(context_dependent_remappings_order_independent_2)
 	BOOST_CHECK(c.compile());
 }
 
+BOOST_AUTO_TEST_CASE(update_sources)
+{
+	CompilerStack c;
+	c.setSources({
+		{"a.sol", "pragma solidity >=0.0; contract A { function f() public pure virtual returns (uint) { return 1; } }"},
+		{"b.sol", "pragma solidity >=0.0; import \"a.sol\"; contract B is A { function g() public pure returns (uint) { return f(); } }"},
+		{"c.sol", "pragma solidity >=0.0; contract C { uint x; function h() public pure { uint x; } }"}
+	});
+	c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(c.compile());
+	size_t warningCount = c.errors().size();
+	BOOST_CHECK(warningCount > 0);
+	SourceUnit const* a = &c.ast("a.sol");
+	SourceUnit const* b = &c.ast("b.sol");
+	SourceUnit const* sourceC = &c.ast("c.sol");
+
+	// Only the changed source is analysed again, the warnings of the others are kept.
+	c.updateSources({
+		{"b.sol", "pragma solidity >=0.0; import \"a.sol\"; contract B is A { function g() public pure returns (uint) { return f() + 1; } }"}
+	});
+	BOOST_REQUIRE(c.parseAndAnalyze());
+	BOOST_CHECK_EQUAL(c.errors().size(), warningCount);
+	BOOST_CHECK(&c.ast("a.sol") == a);
+	BOOST_CHECK(&c.ast("c.sol") == sourceC);
+	BOOST_CHECK(&c.ast("b.sol") != b);
+	BOOST_CHECK(c.compile());
+	BOOST_CHECK(!c.object("B").bytecode.empty());
+
+	// Sources importing a changed source are analysed again as well.
+	b = &c.ast("b.sol");
+	c.updateSources({
+		{"a.sol", "pragma solidity >=0.0; contract A { function f() public pure virtual returns (uint) { return 2; } }"}
+	});
+	BOOST_REQUIRE(c.parseAndAnalyze());
+	BOOST_CHECK_EQUAL(c.errors().size(), warningCount);
+	BOOST_CHECK(&c.ast("a.sol") != a);
+	BOOST_CHECK(&c.ast("b.sol") != b);
+	BOOST_CHECK(&c.ast("c.sol") == sourceC);
+	BOOST_CHECK(c.compile());
+}
+
+BOOST_AUTO_TEST_CASE(update_sources_after_error)
+{
+	CompilerStack c;
+	c.setSources({
+		{"a.sol", "pragma solidity >=0.0; contract A { function f() public pure returns (uint) { return 1; } }"},
+		{"b.sol", "pragma solidity >=0.0; import \"a.sol\"; contract B is A {}"},
+		{"c.sol", "pragma solidity >=0.0; contract C {}"}
+	});
+	c.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	BOOST_REQUIRE(c.parseAndAnalyze());
+	SourceUnit const* a = &c.ast("a.sol");
+
+	c.updateSources({{"b.sol", "pragma solidity >=0.0; import \"a.sol\"; contract B is A { function g() public { x = 1; } }"}});
+	BOOST_CHECK(!c.parseAndAnalyze());
+	BOOST_CHECK(langutil::Error::containsErrorOfType(c.errors(), langutil::Error::Type::DeclarationError));
+	BOOST_CHECK(&c.ast("a.sol") == a);
+
+	c.updateSources({{"b.sol", "pragma solidity >=0.0; import \"a.sol\"; contract B is A { uint x; function g() public { x = f(); } }"}});
+	BOOST_REQUIRE(c.parseAndAnalyze());
+	BOOST_CHECK(langutil::Error::containsOnlyWarnings(c.errors()));
+	BOOST_CHECK(&c.ast("a.sol") == a);
+	BOOST_CHECK(c.compile());
+}
+
+BOOST_AUTO_TEST_CASE(parse_concurrently)
+{
+	StringMap sources{
+		{"a.sol", "pragma solidity >=0.0; contract A { function f() public pure returns (uint) { return uint8(1); } }"},
+		{"b.sol", "pragma solidity >=0.0; import \"a.sol\"; contract B is A { uint[] x; }"},
+		{"c.sol", "pragma solidity >=0.0; contract C { function g() public { bytes32 y = keccak256(\"\"); } }"},
+		{"d.sol", "pragma solidity >=0.0; contract D { function h() public { uint z = ; } }"},
+		{"e.sol", "pragma solidity >=0.0; import \"c.sol\"; contract E is C { enum X { Y } }"},
+		{"f.sol", "pragma solidity >=0.0; import {A as AA} from \"a.sol\"; contract F is AA {}"},
+		{"g.sol", "pragma solidity >=0.0; import {A} from \"a.sol\"; import {B} from \"b.sol\"; contract G is A, B {}"}
+	};
+	// Only one compiler stack can exist at a time, so the results are converted to strings.
+	auto parse = [&](size_t _threadCount)
+	{
+		CompilerStack c;
+		c.setSources(sources);
+		c.setParserErrorRecovery(true);
+		c.setThreadCount(_threadCount);
+		BOOST_CHECK(!c.parse());
+		vector<string> result;
+		for (auto const& error: c.errors())
+			result.emplace_back(to_string(error->errorId().error));
+		for (auto const& source: sources)
+			result.emplace_back(util::jsonCompactPrint(ASTJsonConverter(CompilerStack::State::Parsed).toJson(c.ast(source.first))));
+		return result;
+	};
+
+	// The node IDs and the errors do not depend on the number of threads.
+	vector<string> sequential = parse(1);
+	vector<string> concurrent = parse(4);
+	BOOST_CHECK_EQUAL_COLLECTIONS(sequential.begin(), sequential.end(), concurrent.begin(), concurrent.end());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
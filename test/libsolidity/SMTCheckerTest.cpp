@@ -51,6 +51,10 @@ SMTCheckerTest::SMTCheckerTest(string const& _filename): SyntaxTest(_filename, E
 	else
 		BOOST_THROW_EXCEPTION(runtime_error("Invalid SMT engine choice."));
 
+	m_threadCount = m_reader.sizetSetting("SMTThreads", 1);
+	if (m_threadCount == 0)
+		BOOST_THROW_EXCEPTION(runtime_error("Invalid SMT thread count."));
+
 	if (m_enabledSolvers.none() || m_modelCheckerSettings.engine.none())
 		m_shouldRun = false;
 
@@ -68,6 +72,7 @@ TestCase::TestResult SMTCheckerTest::run(ostream& _stream, string const& _linePr
 	setupCompiler();
 	compiler().setSMTSolverChoice(m_enabledSolvers);
 	compiler().setModelCheckerSettings(m_modelCheckerSettings);
+	compiler().setThreadCount(m_threadCount);
 	parseAndAnalyze();
 	filterObtainedErrors();
 
@@ -54,6 +54,10 @@ protected:
 	/// where if none is given the default used option is `all`.
 	smtutil::SMTSolverChoice m_enabledSolvers;
 
+	/// This is set via option SMTThreads in the test.
+	/// The default is 1.
+	size_t m_threadCount = 1;
+
 	bool m_ignoreCex = false;
 };
 
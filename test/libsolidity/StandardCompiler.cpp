@@ -22,13 +22,17 @@
 
 #include <string>
 #include <boost/test/unit_test.hpp>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/CommonIO.h>
 #include <test/Metadata.h>
 
+#include <boost/filesystem.hpp>
+
 #include <algorithm>
 #include <set>
 
@@ -1755,6 +1759,126 @@ BOOST_AUTO_TEST_CASE(dependency_tracking_of_abstract_contract_yul)
 	BOOST_REQUIRE(result["sources"].size() == 1);
 }
 
+BOOST_AUTO_TEST_CASE(compilation_cache)
+{
+	string input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"*": { "*": ["evm.bytecode", "evm.deployedBytecode", "metadata", "ir"] }
+			}
+		},
+		"sources": {
+			"A.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0; library L { function f() external pure returns (uint) { return 7; } } contract C { uint immutable x = 1; function g() public view returns (uint) { return L.f() + x; } }"
+			}
+		}
+	}
+	)";
+	namespace fs = boost::filesystem;
+	fs::path directory = fs::temp_directory_path() / fs::unique_path("solidity-compilation-cache-%%%%-%%%%-%%%%");
+	auto cache = make_shared<CompilationCache>(directory);
+
+	Json::Value expected = compile(input);
+	BOOST_REQUIRE(expected["contracts"]["A.sol"]["C"]["evm"]["bytecode"]["linkReferences"]["A.sol"].isMember("L"));
+	BOOST_REQUIRE(expected["contracts"]["A.sol"]["C"]["evm"]["deployedBytecode"]["immutableReferences"].size() == 1);
+
+	// The first run fills the cache, the second one takes the results from it.
+	for (size_t run = 0; run < 2; ++run)
+	{
+		solidity::frontend::StandardCompiler compiler({}, cache);
+		Json::Value result;
+		BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(input), result));
+		BOOST_CHECK(result == expected);
+	}
+	BOOST_CHECK_EQUAL(distance(fs::directory_iterator(directory), fs::directory_iterator()), 2);
+
+	// Modified entries show that the results are actually taken from the cache.
+	for (auto const& entry: fs::directory_iterator(directory))
+	{
+		Json::Value content;
+		BOOST_REQUIRE(util::jsonParseStrict(util::readFileAsString(entry.path().string()), content));
+		content["ir"] = "/* cached */";
+		fs::ofstream(entry.path(), ios::trunc) << util::jsonCompactPrint(content);
+	}
+	{
+		solidity::frontend::StandardCompiler compiler({}, cache);
+		Json::Value result;
+		BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(input), result));
+		BOOST_CHECK_EQUAL(result["contracts"]["A.sol"]["C"]["ir"].asString(), "/* cached */");
+		BOOST_CHECK_EQUAL(result["contracts"]["A.sol"]["L"]["ir"].asString(), "/* cached */");
+		result["contracts"]["A.sol"]["C"]["ir"] = expected["contracts"]["A.sol"]["C"]["ir"];
+		result["contracts"]["A.sol"]["L"]["ir"] = expected["contracts"]["A.sol"]["L"]["ir"];
+		BOOST_CHECK(result == expected);
+	}
+
+	// Invalid entries are ignored.
+	for (auto const& entry: fs::directory_iterator(directory))
+		fs::ofstream(entry.path(), ios::trunc) << "{\"object\": 1}";
+	solidity::frontend::StandardCompiler compiler({}, cache);
+	Json::Value result;
+	BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(input), result));
+	BOOST_CHECK(result == expected);
+
+	fs::remove_all(directory);
+}
+
+BOOST_AUTO_TEST_CASE(yul_optimizer_profile)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "enabled": true },
+			"viaIR": true,
+			"outputSelection": {
+				"*": { "C": ["yulOptimizerProfile"], "D": ["*"] }
+			}
+		},
+		"sources": {
+			"A.sol": {
+				"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0; contract C { function f(uint x) public pure returns (uint) { return x + 1; } } contract D {}"
+			}
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+
+	// The wildcard does not select the profile.
+	BOOST_CHECK(!result["contracts"]["A.sol"]["D"].isMember("yulOptimizerProfile"));
+
+	Json::Value const& profile = result["contracts"]["A.sol"]["C"]["yulOptimizerProfile"];
+	for (char const* stage: {"ir", "bytecode"})
+	{
+		BOOST_REQUIRE(profile[stage].isObject());
+		// Creation and deployed object.
+		BOOST_REQUIRE_EQUAL(profile[stage].size(), 2);
+		for (string const& objectName: profile[stage].getMemberNames())
+		{
+			Json::Value const& objectProfile = profile[stage][objectName];
+			BOOST_CHECK(objectProfile["time"].isUInt64());
+			BOOST_REQUIRE(objectProfile["steps"].isObject());
+			BOOST_CHECK(!objectProfile["steps"].empty());
+			for (string const& abbreviation: objectProfile["steps"].getMemberNames())
+			{
+				Json::Value const& step = objectProfile["steps"][abbreviation];
+				BOOST_CHECK_EQUAL(abbreviation.size(), 1);
+				BOOST_CHECK(step["name"].isString());
+				BOOST_CHECK(step["invocations"].asUInt() > 0);
+				BOOST_CHECK(step["skipped"].isUInt64());
+				BOOST_CHECK(step["time"].isUInt64());
+				BOOST_CHECK(step["codeSizeBefore"].isUInt64());
+				BOOST_CHECK(step["codeSizeAfter"].isUInt64());
+			}
+			BOOST_REQUIRE(objectProfile["fixpointIterations"].isArray());
+			BOOST_CHECK(!objectProfile["fixpointIterations"].empty());
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -19,8 +19,8 @@ contract C {
 //   totalCost: 1182627
 // external:
 //   a(): 1130
-//   b(uint256): infinite
-//   f1(uint256): infinite
+//   b(uint256): 2370
+//   f1(uint256): 638
 //   f2(uint256[],string[],uint16,address): infinite
 //   f3(uint16[],string[],uint16,address): infinite
 //   f4(uint32[],string[12],bytes[2][],address): infinite
@@ -29,24 +29,24 @@ contract Large {
 //   totalCost: 914348
 // external:
 //   a(): 1175
-//   b(uint256): infinite
-//   f0(uint256): infinite
-//   f1(uint256): infinite
-//   f2(uint256): infinite
-//   f3(uint256): infinite
-//   f4(uint256): infinite
-//   f5(uint256): infinite
-//   f6(uint256): infinite
-//   f7(uint256): infinite
-//   f8(uint256): infinite
-//   f9(uint256): infinite
-//   g0(uint256): infinite
-//   g1(uint256): infinite
-//   g2(uint256): infinite
-//   g3(uint256): infinite
-//   g4(uint256): infinite
-//   g5(uint256): infinite
-//   g6(uint256): infinite
-//   g7(uint256): infinite
-//   g8(uint256): infinite
-//   g9(uint256): infinite
+//   b(uint256): 2348
+//   f0(uint256): 729
+//   f1(uint256): 41654
+//   f2(uint256): 21595
+//   f3(uint256): 21683
+//   f4(uint256): 21661
+//   f5(uint256): 21639
+//   f6(uint256): 21662
+//   f7(uint256): 21574
+//   f8(uint256): 21574
+//   f9(uint256): 21596
+//   g0(uint256): 615
+//   g1(uint256): 41609
+//   g2(uint256): 21572
+//   g3(uint256): 21660
+//   g4(uint256): 21638
+//   g5(uint256): 21594
+//   g6(uint256): 21617
+//   g7(uint256): 21616
+//   g8(uint256): 21594
+//   g9(uint256): 21551
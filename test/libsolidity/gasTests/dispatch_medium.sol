@@ -16,11 +16,11 @@ contract Medium {
 //   totalCost: 360799
 // external:
 //   a(): 1152
-//   b(uint256): infinite
-//   f1(uint256): infinite
-//   f2(uint256): infinite
-//   f3(uint256): infinite
-//   g0(uint256): infinite
-//   g7(uint256): infinite
-//   g8(uint256): infinite
-//   g9(uint256): infinite
+//   b(uint256): 2348
+//   f1(uint256): 41565
+//   f2(uint256): 21595
+//   f3(uint256): 21639
+//   g0(uint256): 615
+//   g7(uint256): 21594
+//   g8(uint256): 21572
+//   g9(uint256): 21528
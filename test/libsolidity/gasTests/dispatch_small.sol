@@ -12,5 +12,5 @@ contract Small {
 // external:
 //   fallback: 129
 //   a(): 1107
-//   b(uint256): infinite
-//   f1(uint256): infinite
+//   b(uint256): 2304
+//   f1(uint256): 41565
@@ -24,6 +24,6 @@ contract C {
 //   totalCost: 119965
 // external:
 //   exp_neg_one(uint256): 2259
-//   exp_one(uint256): infinite
-//   exp_two(uint256): infinite
-//   exp_zero(uint256): infinite
+//   exp_one(uint256): 2215
+//   exp_two(uint256): 2193
+//   exp_zero(uint256): 2237
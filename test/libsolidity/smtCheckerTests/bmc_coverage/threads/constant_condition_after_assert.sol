@@ -0,0 +1,14 @@
+pragma experimental SMTChecker;
+contract C {
+	function f(uint x) public pure {
+		assert(x > 0);
+		if (x == x) {}
+	}
+}
+// ====
+// SMTEngine: bmc
+// SMTSolvers: z3
+// SMTThreads: 4
+// ----
+// Warning 4661: (81-94): BMC: Assertion violation happens here.
+// Warning 6838: (102-108): BMC: Condition is always true.
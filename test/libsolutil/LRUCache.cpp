@@ -0,0 +1,61 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/LRUCache.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(LRUCacheTest)
+
+BOOST_AUTO_TEST_CASE(get_and_set)
+{
+	LRUCache<int, string> cache(2);
+	BOOST_CHECK(!cache.get(1));
+	cache.set(1, "one");
+	cache.set(2, "two");
+	BOOST_CHECK(cache.get(1) == string("one"));
+	BOOST_CHECK(cache.get(2) == string("two"));
+	cache.set(2, "zwei");
+	BOOST_CHECK(cache.get(2) == string("zwei"));
+	BOOST_CHECK_EQUAL(cache.size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(evicts_least_recently_used)
+{
+	LRUCache<int, string> cache(2);
+	cache.set(1, "one");
+	cache.set(2, "two");
+	// Makes 2 the least recently used entry.
+	BOOST_CHECK(cache.get(1));
+	cache.set(3, "three");
+	BOOST_CHECK_EQUAL(cache.size(), 2);
+	BOOST_CHECK(!cache.get(2));
+	BOOST_CHECK(cache.get(1) == string("one"));
+	BOOST_CHECK(cache.get(3) == string("three"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,163 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for Word256, compared against the operations on u256.
+ */
+
+#include <libsolutil/Word256.h>
+
+#include <libsolutil/FixedHash.h>
+#include <libsolutil/Keccak256.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+/// @returns values at the limb boundaries and pseudo-random values of different lengths.
+vector<u256> testValues()
+{
+	vector<u256> values{0, 1, 2, 3, 7, 255, 256};
+	for (unsigned bits: {31u, 32u, 63u, 64u, 65u, 127u, 128u, 129u, 191u, 192u, 254u, 255u})
+	{
+		values.emplace_back(u256(1) << bits);
+		values.emplace_back((u256(1) << bits) - 1);
+		values.emplace_back((u256(1) << bits) + 1);
+	}
+	values.emplace_back(u256(-1));
+	values.emplace_back(u256(-2));
+	for (unsigned i = 0; i < 16; ++i)
+		values.emplace_back(u256(keccak256(to_string(i))) >> (16 * i));
+	return values;
+}
+
+u256 word(Word256 const& _value) { return u256(_value); }
+
+}
+
+BOOST_AUTO_TEST_SUITE(Word256Test)
+
+BOOST_AUTO_TEST_CASE(constexpr_evaluation)
+{
+	constexpr Word256 max = ~Word256{};
+	static_assert(max + 1 == 0);
+	static_assert(Word256(1) << 255 == Word256(uint64_t(1) << 63, 0, 0, 0));
+	static_assert(max / 3 == Word256(0x5555555555555555, 0x5555555555555555, 0x5555555555555555, 0x5555555555555555));
+	static_assert(power(2, 255) == (Word256(1) << 255));
+	static_assert(signedDiv(-Word256(6), 3) == -Word256(2));
+	static_assert(mulMod(max, max, 12) == 9);
+	BOOST_CHECK(true);
+}
+
+BOOST_AUTO_TEST_CASE(conversion)
+{
+	for (u256 const& value: testValues())
+	{
+		BOOST_CHECK_EQUAL(word(Word256(value)), value);
+		BOOST_CHECK_EQUAL(Word256(value).bitLength(), value == 0 ? 0 : boost::multiprecision::msb(value) + 1);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(unsigned_arithmetic)
+{
+	vector<u256> values = testValues();
+	for (u256 const& a: values)
+	{
+		BOOST_CHECK_EQUAL(word(~Word256(a)), u256(~a));
+		BOOST_CHECK_EQUAL(word(-Word256(a)), u256(0 - a));
+		for (u256 const& b: values)
+		{
+			Word256 x(a);
+			Word256 y(b);
+			BOOST_CHECK_EQUAL(word(x + y), u256(a + b));
+			BOOST_CHECK_EQUAL(word(x - y), u256(a - b));
+			BOOST_CHECK_EQUAL(word(x * y), u256(a * b));
+			BOOST_CHECK_EQUAL(word(x / y), b == 0 ? 0 : u256(bigint(a) / bigint(b)));
+			BOOST_CHECK_EQUAL(word(x % y), b == 0 ? 0 : u256(bigint(a) % bigint(b)));
+			BOOST_CHECK_EQUAL(word(x & y), u256(a & b));
+			BOOST_CHECK_EQUAL(word(x | y), u256(a | b));
+			BOOST_CHECK_EQUAL(word(x ^ y), u256(a ^ b));
+			BOOST_CHECK_EQUAL(x < y, a < b);
+			BOOST_CHECK_EQUAL(x == y, a == b);
+			BOOST_CHECK_EQUAL(word(power(x, y)), u256(boost::multiprecision::powm(bigint(a), bigint(b), bigint(1) << 256)));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(shifts)
+{
+	for (u256 const& a: testValues())
+		for (unsigned amount: {0u, 1u, 8u, 63u, 64u, 65u, 128u, 200u, 255u, 256u, 1000u})
+		{
+			BOOST_CHECK_EQUAL(word(Word256(a) << amount), amount >= 256 ? 0 : u256((bigint(a) << amount) & u256(-1)));
+			BOOST_CHECK_EQUAL(word(Word256(a) >> amount), amount >= 256 ? 0 : u256(a >> amount));
+			u256 sar = amount >= 256 ? 0 : u256(a >> amount);
+			if (boost::multiprecision::bit_test(a, 255))
+				sar = amount >= 256 ? u256(-1) : u256(sar | (amount == 0 ? u256(0) : u256(u256(-1) << (256 - amount))));
+			BOOST_CHECK_EQUAL(word(arithmeticShiftRight(Word256(a), amount)), sar);
+		}
+}
+
+BOOST_AUTO_TEST_CASE(signed_arithmetic)
+{
+	vector<u256> values = testValues();
+	for (u256 const& a: values)
+		for (u256 const& b: values)
+		{
+			Word256 x(a);
+			Word256 y(b);
+			BOOST_CHECK_EQUAL(word(signedDiv(x, y)), b == 0 ? 0 : s2u(s256(bigint(u2s(a)) / bigint(u2s(b)))));
+			BOOST_CHECK_EQUAL(word(signedMod(x, y)), b == 0 ? 0 : s2u(s256(bigint(u2s(a)) % bigint(u2s(b)))));
+			BOOST_CHECK_EQUAL(signedLessThan(x, y), u2s(a) < u2s(b));
+			if (b < 40)
+			{
+				u256 expectation = b;
+				if (a < 31)
+				{
+					unsigned testBit = unsigned(a) * 8 + 7;
+					u256 mask = (u256(1) << testBit) - 1;
+					expectation = boost::multiprecision::bit_test(b, testBit) ? u256(b | ~mask) : u256(b & mask);
+				}
+				BOOST_CHECK_EQUAL(word(signExtend(x, y)), expectation);
+			}
+		}
+}
+
+BOOST_AUTO_TEST_CASE(modular_arithmetic)
+{
+	vector<u256> values = testValues();
+	for (u256 const& a: values)
+		for (u256 const& b: values)
+			for (u256 const& modulus: {u256(0), u256(1), u256(7), u256(1) << 64, u256(-1), b ^ a, b + 5})
+			{
+				Word256 x(a);
+				Word256 y(b);
+				Word256 m(modulus);
+				BOOST_CHECK_EQUAL(word(addMod(x, y, m)), modulus == 0 ? 0 : u256((bigint(a) + bigint(b)) % bigint(modulus)));
+				BOOST_CHECK_EQUAL(word(mulMod(x, y, m)), modulus == 0 ? 0 : u256((bigint(a) * bigint(b)) % bigint(modulus)));
+			}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
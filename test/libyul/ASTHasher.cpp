@@ -0,0 +1,115 @@
+/*
+    This file is part of solidity.
+
+    solidity is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    solidity is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the AST hasher.
+ */
+
+#include <test/Common.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/optimiser/ASTHasher.h>
+#include <libyul/optimiser/Suite.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/AsmPrinter.h>
+#include <libyul/AST.h>
+#include <libyul/Object.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+uint64_t hash(string const& _source)
+{
+	shared_ptr<Block> ast = parse(_source, false).first;
+	BOOST_REQUIRE(ast);
+	return ASTHasher::run(*ast);
+}
+
+/// Optimises @a _source with @a _sequence and @returns the optimised code and the profile.
+pair<string, OptimiserSuiteProfile> optimise(string const& _source, string const& _sequence)
+{
+	auto [ast, analysisInfo] = parse(_source, false);
+	BOOST_REQUIRE(ast);
+	Object object;
+	object.code = ast;
+	object.analysisInfo = analysisInfo;
+	EVMDialect const& dialect = EVMDialect::strictAssemblyForEVM(solidity::test::CommonOptions::get().evmVersion());
+	GasMeter meter(dialect, false, 200);
+	OptimiserSuiteProfile profile;
+	OptimiserSuite::run(dialect, &meter, object, true, _sequence, {}, &profile);
+	return {AsmPrinter{dialect}(*object.code), profile};
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulASTHasher)
+
+BOOST_AUTO_TEST_CASE(equal_code)
+{
+	BOOST_CHECK_EQUAL(
+		hash("{ let x := add(1, 2) if x { sstore(0, x) } }"),
+		hash("{\n  let x := add(1, 2)\n  if x {\n    sstore(0, x)\n  }\n}")
+	);
+}
+
+BOOST_AUTO_TEST_CASE(differing_code)
+{
+	string const source = "{ let x := add(1, 2) if x { sstore(0, x) } }";
+	uint64_t const reference = hash(source);
+	BOOST_CHECK_NE(reference, hash("{ let y := add(1, 2) if y { sstore(0, y) } }"));
+	BOOST_CHECK_NE(reference, hash("{ let x := add(2, 1) if x { sstore(0, x) } }"));
+	BOOST_CHECK_NE(reference, hash("{ let x := add(1, 2) if x { sstore(0, x) } sstore(0, x) }"));
+	BOOST_CHECK_NE(reference, hash("{ let x := add(1, 2) if x { } sstore(0, x) }"));
+	BOOST_CHECK_NE(hash("{ let x x := 1 }"), hash("{ let x := 1 }"));
+	BOOST_CHECK_NE(hash("{ function f(a) {} }"), hash("{ function f() -> a {} }"));
+	BOOST_CHECK_NE(
+		hash("{ switch calldataload(0) case 0 { sstore(0, 1) } default { sstore(0, 2) } }"),
+		hash("{ switch calldataload(0) case 0 { sstore(0, 2) } default { sstore(0, 1) } }")
+	);
+}
+
+BOOST_AUTO_TEST_CASE(optimiser_suite_skips_unchanged_steps)
+{
+	string const source = "{ let x := add(calldataload(0), 0) let y := mul(x, 1) sstore(0, y) }";
+	// The bracketed steps are repeated until the code does not change anymore,
+	// so running them again afterwards cannot change the code.
+	auto const [reference, referenceProfile] = optimise(source, "[scu]");
+	auto const [repeated, repeatedProfile] = optimise(source, "[scu] scu");
+
+	BOOST_CHECK_EQUAL(repeated, reference);
+	for (char step: string("scu"))
+	{
+		auto const& referenceStatistics = referenceProfile.steps.at(step);
+		auto const& repeatedStatistics = repeatedProfile.steps.at(step);
+		BOOST_CHECK_EQUAL(repeatedStatistics.invocations, referenceStatistics.invocations);
+		BOOST_CHECK_EQUAL(repeatedStatistics.skipped, referenceStatistics.skipped + 1);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,98 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the Yul assembly stack.
+ */
+
+#include <test/Common.h>
+
+#include <libyul/AssemblyStack.h>
+
+#include <libevmasm/LinkerObject.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <utility>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulAssemblyStack)
+
+BOOST_AUTO_TEST_CASE(optimize_concurrently)
+{
+	string code;
+	for (string const& name: {"A", "B", "C", "D"})
+		code += R"(
+			object ")" + name + R"(" {
+				code {
+					let size := datasize(")" + name + R"(_deployed")
+					datacopy(0, dataoffset(")" + name + R"(_deployed"), size)
+					sstore(0, f(calldataload(0)))
+					return(0, size)
+					function f(x) -> y {
+						for { let i := 0 } lt(i, x) { i := add(i, 1) } { y := add(y, mul(i, 0x100000000000000000000)) }
+					}
+				}
+				object ")" + name + R"(_deployed" {
+					code {
+						let a := calldataload(0)
+						let b := and(not(0), a)
+						switch shr(224, b)
+						case 0x12345678 { mstore(0, g(a, 0)) return(0, 32) }
+						default { revert(0, 0) }
+						function g(x, c) -> r { r := add(mul(x, 0xffffffffffffffffffff00), c) }
+					}
+					data "meta" hex"c0ffee"
+				}
+			}
+		)";
+	code = "object \"O\" { code { sstore(0, 1) }" + code + "}";
+
+	auto compile = [&](size_t _threadCount) {
+		AssemblyStack stack(
+			solidity::test::CommonOptions::get().evmVersion(),
+			AssemblyStack::Language::StrictAssembly,
+			solidity::frontend::OptimiserSettings::full()
+		);
+		stack.setThreadCount(_threadCount);
+		BOOST_REQUIRE(stack.parseAndAnalyze("source", code));
+		stack.optimize();
+		MachineAssemblyObject object = stack.assemble(AssemblyStack::Machine::EVM);
+		BOOST_REQUIRE(object.bytecode);
+		return make_pair(stack.print(), object.bytecode->toHex());
+	};
+
+	auto expectation = compile(1);
+	// Repeated to give races a chance to show up.
+	for (size_t run = 0; run < 10; ++run)
+	{
+		auto [printed, bytecode] = compile(4);
+		BOOST_CHECK_EQUAL(printed, expectation.first);
+		BOOST_CHECK_EQUAL(bytecode, expectation.second);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,100 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the YulString repository.
+ */
+
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest)
+
+BOOST_AUTO_TEST_CASE(empty_string)
+{
+	YulString empty{""};
+	BOOST_CHECK(empty.empty());
+	BOOST_CHECK(empty == YulString{});
+	BOOST_CHECK_EQUAL(empty.str(), "");
+	BOOST_CHECK_EQUAL(empty.hash(), YulStringRepository::emptyHash());
+	BOOST_CHECK(!YulString{"x"}.empty());
+}
+
+BOOST_AUTO_TEST_CASE(interning)
+{
+	YulString a{"abc"};
+	YulString b{string("ab") + "c"};
+	YulString c{"abd"};
+	BOOST_CHECK(a == b);
+	BOOST_CHECK(a != c);
+	BOOST_CHECK_EQUAL(a.str(), "abc");
+	BOOST_CHECK_EQUAL(c.str(), "abd");
+	BOOST_CHECK_EQUAL(a.hash(), YulStringRepository::hash("abc"));
+	BOOST_CHECK(!(a < b) && !(b < a));
+	BOOST_CHECK((a < c) != (c < a));
+}
+
+BOOST_AUTO_TEST_CASE(many_strings)
+{
+	vector<YulString> strings;
+	for (size_t i = 0; i < 10000; ++i)
+		strings.emplace_back("many_strings_" + to_string(i));
+	for (size_t i = 0; i < strings.size(); ++i)
+	{
+		BOOST_CHECK_EQUAL(strings[i].str(), "many_strings_" + to_string(i));
+		BOOST_CHECK(strings[i] == YulString{"many_strings_" + to_string(i)});
+	}
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	size_t const stringCount = 2000;
+	// Strides coprime to stringCount, so that every thread interns all strings,
+	// but in a different order. The first thread interns them in ascending order.
+	vector<size_t> const strides{1, 3, 7, 9};
+	size_t const threadCount = strides.size();
+	auto stringIndex = [&](size_t _thread, size_t _i) { return (_i * strides[_thread]) % stringCount; };
+	vector<vector<YulString>> results(threadCount);
+	vector<thread> threads;
+	for (size_t t = 0; t < threadCount; ++t)
+		threads.emplace_back([&, t] {
+			for (size_t i = 0; i < stringCount; ++i)
+				results[t].emplace_back("concurrent_" + to_string(stringIndex(t, i)));
+		});
+	for (thread& t: threads)
+		t.join();
+
+	for (size_t t = 0; t < threadCount; ++t)
+		for (size_t i = 0; i < stringCount; ++i)
+		{
+			size_t n = stringIndex(t, i);
+			BOOST_REQUIRE_EQUAL(results[t][i].str(), "concurrent_" + to_string(n));
+			BOOST_CHECK(results[t][i] == results[0][n]);
+		}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
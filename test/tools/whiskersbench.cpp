@@ -0,0 +1,175 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Microbenchmark for the rendering of Whiskers templates.
+ * Repeatedly generates a fixed set of utility functions via YulUtilFunctions,
+ * which renders the templates used there.
+ */
+
+#include <libsolidity/ast/TypeProvider.h>
+#include <libsolidity/codegen/MultiUseYulFunctionCollector.h>
+#include <libsolidity/codegen/YulUtilFunctions.h>
+#include <libsolidity/interface/DebugSettings.h>
+
+#include <liblangutil/EVMVersion.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// Generates the utility functions and @returns the size of the generated code in bytes.
+size_t generateFunctions()
+{
+	MultiUseYulFunctionCollector collector;
+	YulUtilFunctions utils(EVMVersion{}, RevertStrings::Default, collector);
+
+	for (unsigned bits: {8u, 64u, 256u})
+		for (auto modifier: {IntegerType::Modifier::Unsigned, IntegerType::Modifier::Signed})
+		{
+			IntegerType const& type = *TypeProvider::integer(bits, modifier);
+			utils.overflowCheckedIntAddFunction(type);
+			utils.overflowCheckedIntSubFunction(type);
+			utils.overflowCheckedIntMulFunction(type);
+			utils.overflowCheckedIntDivFunction(type);
+			utils.intModFunction(type);
+			utils.wrappingIntAddFunction(type);
+			utils.incrementCheckedFunction(type);
+			utils.decrementCheckedFunction(type);
+			utils.cleanupFunction(type);
+			utils.validatorFunction(type, true);
+			utils.conversionFunction(type, *TypeProvider::uint256());
+			utils.conversionFunction(*TypeProvider::uint256(), type);
+			utils.readFromStorage(type, 0, true);
+			utils.readFromMemory(type);
+			utils.readFromCalldata(type);
+			utils.writeToMemoryFunction(type);
+			utils.updateStorageValueFunction(type, type, 0);
+			utils.zeroValueFunction(type);
+			utils.storageSetToZeroFunction(type);
+			if (type.isSigned())
+				utils.negateNumberCheckedFunction(type);
+		}
+
+	for (ArrayType const* type: {
+		TypeProvider::array(DataLocation::Memory, TypeProvider::uint256()),
+		TypeProvider::array(DataLocation::Storage, TypeProvider::uint256()),
+		TypeProvider::bytesMemory(),
+		TypeProvider::bytesStorage()
+	})
+	{
+		utils.arrayLengthFunction(*type);
+		utils.arrayDataAreaFunction(*type);
+		if (type->location() == DataLocation::Memory)
+		{
+			utils.arrayAllocationSizeFunction(*type);
+			utils.allocateMemoryArrayFunction(*type);
+		}
+		else
+		{
+			utils.storageArrayPushFunction(*type);
+			utils.storageArrayPopFunction(*type);
+		}
+		if (!type->isByteArray())
+		{
+			utils.nextArrayElementFunction(*type);
+			if (type->location() == DataLocation::Memory)
+				utils.memoryArrayIndexAccessFunction(*type);
+			else
+				utils.clearStorageArrayFunction(*type);
+		}
+	}
+
+	for (size_t bits: {8u, 96u, 224u})
+	{
+		utils.shiftLeftFunction(bits);
+		utils.shiftRightFunction(bits);
+	}
+	utils.copyToMemoryFunction(true);
+	utils.copyToMemoryFunction(false);
+	utils.roundUpFunction();
+	utils.allocationFunction();
+	utils.extractByteArrayLengthFunction();
+	utils.panicFunction(util::PanicCode::UnderOverflow);
+
+	string const code = collector.requestedFunctions();
+	return code.size();
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(whiskersbench, microbenchmark for the rendering of Whiskers templates.
+Usage: whiskersbench [Options]
+Repeatedly generates the Yul utility functions used by the IR code generator.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		(
+			"iterations",
+			po::value<size_t>()->default_value(200),
+			"number of times the functions are generated"
+		)
+		("help", "Show this help screen.");
+
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::parse_command_line(argc, argv, options), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	size_t iterations = arguments["iterations"].as<size_t>();
+	size_t codeSize = 0;
+	auto start = chrono::steady_clock::now();
+	for (size_t i = 0; i < iterations; ++i)
+		codeSize += generateFunctions();
+	auto duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+
+	cout << "Iterations: " << iterations << endl;
+	cout << "Generated code: " << codeSize / max<size_t>(iterations, 1) << " bytes per iteration" << endl;
+	cout << "Total time: " << duration.count() / 1000 << " ms" << endl;
+	cout << "Time per iteration: " << duration.count() / max<size_t>(iterations, 1) << " us" << endl;
+
+	return 0;
+}
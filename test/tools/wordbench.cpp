@@ -0,0 +1,331 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Microbenchmark for the 256-bit arithmetic used when folding constants in the
+ * simplification rules and when interpreting Yul.
+ * Evaluates the same operations on u256 (as the code did before util::Word256 was
+ * introduced) and on util::Word256 and reports the throughput of both.
+ * Also reports the throughput of folding the operations with the simplification rules
+ * of the Yul optimiser and of the Yul interpreter, which both use util::Word256.
+ */
+
+#include <test/tools/yulInterpreter/Interpreter.h>
+
+#include <libyul/AssemblyStack.h>
+#include <libyul/AST.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/ASTCopier.h>
+#include <libyul/optimiser/ExpressionSimplifier.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+
+#include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/Word256.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+using u512 = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<512, 256, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void>>;
+
+struct Operation
+{
+	string name;
+	function<u256(u256 const&, u256 const&, u256 const&)> onU256;
+	function<Word256(Word256 const&, Word256 const&, Word256 const&)> onWord256;
+	size_t arguments = 2;
+};
+
+vector<Operation> operations()
+{
+	return {
+		{
+			"mul",
+			[](u256 const& _a, u256 const& _b, u256 const&) { return _a * _b; },
+			[](Word256 const& _a, Word256 const& _b, Word256 const&) { return _a * _b; }
+		},
+		{
+			"div",
+			[](u256 const& _a, u256 const& _b, u256 const&) { return _b == 0 ? 0 : u256(bigint(_a) / bigint(_b)); },
+			[](Word256 const& _a, Word256 const& _b, Word256 const&) { return _a / _b; }
+		},
+		{
+			"mod",
+			[](u256 const& _a, u256 const& _b, u256 const&) { return _b == 0 ? 0 : u256(bigint(_a) % bigint(_b)); },
+			[](Word256 const& _a, Word256 const& _b, Word256 const&) { return _a % _b; }
+		},
+		{
+			"sdiv",
+			[](u256 const& _a, u256 const& _b, u256 const&) { return _b == 0 ? 0 : s2u(u2s(_a) / u2s(_b)); },
+			[](Word256 const& _a, Word256 const& _b, Word256 const&) { return signedDiv(_a, _b); }
+		},
+		{
+			"smod",
+			[](u256 const& _a, u256 const& _b, u256 const&) { return _b == 0 ? 0 : s2u(u2s(_a) % u2s(_b)); },
+			[](Word256 const& _a, Word256 const& _b, Word256 const&) { return signedMod(_a, _b); }
+		},
+		{
+			"slt",
+			[](u256 const& _a, u256 const& _b, u256 const&) { return u256(u2s(_a) < u2s(_b) ? 1 : 0); },
+			[](Word256 const& _a, Word256 const& _b, Word256 const&) { return Word256(signedLessThan(_a, _b) ? 1 : 0); }
+		},
+		{
+			"exp",
+			[](u256 const& _a, u256 const& _b, u256 const&) { return exp256(_a, _b & 0xffff); },
+			[](Word256 const& _a, Word256 const& _b, Word256 const&) { return power(_a, _b & 0xffff); }
+		},
+		{
+			"shl",
+			[](u256 const& _a, u256 const& _b, u256 const&) { return u256((bigint(_a) << unsigned(_b & 0xff)) & u256(-1)); },
+			[](Word256 const& _a, Word256 const& _b, Word256 const&) { return _a << unsigned((_b & 0xff).limb(0)); }
+		},
+		{
+			"addmod",
+			[](u256 const& _a, u256 const& _b, u256 const& _c) { return _c == 0 ? 0 : u256((bigint(_a) + bigint(_b)) % _c); },
+			[](Word256 const& _a, Word256 const& _b, Word256 const& _c) { return addMod(_a, _b, _c); },
+			3
+		},
+		{
+			"mulmod",
+			[](u256 const& _a, u256 const& _b, u256 const& _c) { return _c == 0 ? 0 : u256((u512(_a) * u512(_b)) % _c); },
+			[](Word256 const& _a, Word256 const& _b, Word256 const& _c) { return mulMod(_a, _b, _c); },
+			3
+		}
+	};
+}
+
+/// @returns pseudo-random values of varying length.
+vector<u256> inputs(size_t _count)
+{
+	vector<u256> values;
+	for (size_t i = 0; i < _count; ++i)
+		values.emplace_back(u256(keccak256(to_string(i))) >> (i % 256));
+	return values;
+}
+
+template <class T, class F>
+chrono::microseconds measure(vector<T> const& _values, size_t _iterations, F const& _operation, T& _checksum)
+{
+	auto start = chrono::steady_clock::now();
+	for (size_t iteration = 0; iteration < _iterations; ++iteration)
+		for (size_t i = 0; i + 2 < _values.size(); ++i)
+			_checksum = _checksum ^ _operation(_values[i], _values[i + 1], _values[i + 2]);
+	return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+}
+
+shared_ptr<Block> parse(string const& _source)
+{
+	AssemblyStack stack(
+		langutil::EVMVersion(),
+		AssemblyStack::Language::StrictAssembly,
+		solidity::frontend::OptimiserSettings::none()
+	);
+	if (!stack.parseAndAnalyze("wordbench", _source) || !stack.errors().empty())
+		return {};
+	return stack.parserResult()->code;
+}
+
+/// Folds one application of @a _operation per input with the simplification rules of the
+/// Yul optimiser and @returns the time needed, including copying the code, or nullopt if
+/// not every application was folded into a literal.
+optional<chrono::microseconds> measureRules(Operation const& _operation, vector<u256> const& _values, size_t _iterations)
+{
+	string source = "{";
+	for (size_t i = 0; i + 2 < _values.size(); ++i)
+	{
+		source += " sstore(0, " + _operation.name + "(";
+		for (size_t argument = 0; argument < _operation.arguments; ++argument)
+			source += (argument > 0 ? ", " : "") + toCompactHexWithPrefix(_values[i + argument]);
+		source += "))";
+	}
+	source += " }";
+	shared_ptr<Block> ast = parse(source);
+	if (!ast)
+		return nullopt;
+
+	Dialect const& dialect = EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion());
+	NameDispenser dispenser(dialect, *ast);
+	set<YulString> const reservedIdentifiers;
+	OptimiserStepContext context{dialect, dispenser, reservedIdentifiers};
+	bool folded = true;
+	auto start = chrono::steady_clock::now();
+	for (size_t iteration = 0; iteration < _iterations; ++iteration)
+	{
+		Block code = std::get<Block>(ASTCopier{}(*ast));
+		ExpressionSimplifier::run(context, code);
+		for (Statement const& statement: code.statements)
+		{
+			auto const& call = std::get<FunctionCall>(std::get<ExpressionStatement>(statement).expression);
+			folded = folded && holds_alternative<Literal>(call.arguments.at(1));
+		}
+	}
+	auto duration = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+	if (!folded)
+		return nullopt;
+	return duration;
+}
+
+/// Runs @a _rounds rounds of a loop over the folded operations in the Yul interpreter
+/// and @returns the time needed or nullopt on failure.
+optional<chrono::microseconds> measureInterpreter(size_t _rounds)
+{
+	shared_ptr<Block> ast = parse(R"({
+		let a := 0x9a4b5c6d7e8f90a1b2c3d4e5f60718293a4b5c6d7e8f90a1b2c3d4e5f6071829
+		let b := 0x1f2e3d4c5b6a79880f1e2d3c4b5a69780f1e2d3c4b5a6978
+		let m := 0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f
+		for { let i := 0 } lt(i, )" + to_string(_rounds) + R"() { i := add(i, 1) } {
+			a := add(mulmod(a, b, m), i)
+			b := xor(sdiv(b, add(i, 1)), shl(and(i, 0xff), a))
+			a := addmod(a, exp(b, 3), m)
+			b := add(smod(a, add(b, 7)), slt(a, b))
+			a := xor(div(a, add(and(b, 0xffff), 1)), mod(b, 0x10001))
+		}
+		sstore(0, a)
+		sstore(1, b)
+	})");
+	if (!ast)
+		return nullopt;
+
+	yul::test::InterpreterState state;
+	auto start = chrono::steady_clock::now();
+	try
+	{
+		yul::test::Interpreter::run(state, EVMDialect::strictAssemblyForEVMObjects(langutil::EVMVersion()), *ast);
+	}
+	catch (yul::test::InterpreterTerminatedGeneric const&)
+	{
+		return nullopt;
+	}
+	return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(wordbench, microbenchmark for 256-bit arithmetic.
+Usage: wordbench [Options]
+Compares the operations of u256 and util::Word256 on pseudo-random inputs.
+
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23);
+	options.add_options()
+		(
+			"iterations",
+			po::value<size_t>()->default_value(200),
+			"number of times the operations are evaluated on all inputs"
+		)
+		(
+			"inputs",
+			po::value<size_t>()->default_value(1000),
+			"number of input values"
+		)
+		("help", "Show this help screen.");
+
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::parse_command_line(argc, argv, options), arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	size_t iterations = arguments["iterations"].as<size_t>();
+	vector<u256> values = inputs(arguments["inputs"].as<size_t>());
+	vector<Word256> words;
+	for (u256 const& value: values)
+		words.emplace_back(value);
+
+	bool mismatch = false;
+	cout << "Operation    u256 (us)  Word256 (us)  Speedup" << endl;
+	for (Operation const& operation: operations())
+	{
+		u256 checksum = 0;
+		Word256 wordChecksum;
+		auto timeU256 = measure(values, iterations, operation.onU256, checksum);
+		auto timeWord256 = measure(words, iterations, operation.onWord256, wordChecksum);
+		if (u256(wordChecksum) != checksum)
+		{
+			cerr << "Results of " << operation.name << " differ." << endl;
+			mismatch = true;
+		}
+		cout <<
+			operation.name << string(13 - operation.name.size(), ' ') <<
+			setw(9) << timeU256.count() << "  " <<
+			setw(12) << timeWord256.count() << "  " <<
+			setw(7) << fixed << setprecision(2) << double(timeU256.count()) / double(max<int64_t>(timeWord256.count(), 1)) << endl;
+	}
+
+	cout << endl << "Operation    simplification rules (us)  folds per ms" << endl;
+	for (Operation const& operation: operations())
+	{
+		auto time = measureRules(operation, values, iterations);
+		if (!time)
+		{
+			cerr << "Applications of " << operation.name << " were not folded." << endl;
+			mismatch = true;
+			continue;
+		}
+		size_t folds = iterations * (values.size() > 2 ? values.size() - 2 : 0);
+		cout <<
+			operation.name << string(13 - operation.name.size(), ' ') <<
+			setw(26) << time->count() << "  " <<
+			setw(12) << folds * 1000 / size_t(max<int64_t>(time->count(), 1)) << endl;
+	}
+
+	cout << endl;
+	size_t const rounds = iterations * 50;
+	if (auto time = measureInterpreter(rounds))
+		cout <<
+			"Interpreter: " << rounds << " loop rounds in " << time->count() << " us, " <<
+			rounds * 1000 / size_t(max<int64_t>(time->count(), 1)) << " rounds per ms" << endl;
+	else
+	{
+		cerr << "The interpreter failed." << endl;
+		mismatch = true;
+	}
+
+	return mismatch ? 1 : 0;
+}
@@ -29,6 +29,7 @@
 #include <libevmasm/Instruction.h>
 
 #include <libsolutil/Keccak256.h>
+#include <libsolutil/Word256.h>
 
 using namespace std;
 using namespace solidity;
@@ -37,6 +38,7 @@ using namespace solidity::yul::test;
 
 using solidity::util::h256;
 using solidity::util::keccak256;
+using solidity::util::Word256;
 
 namespace
 {
@@ -78,8 +80,6 @@ void copyZeroExtended(
 
 }
 
-using u512 = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<512, 256, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void>>;
-
 u256 EVMInstructionInterpreter::eval(
 	evmasm::Instruction _instruction,
 	vector<u256> const& _arguments
@@ -100,19 +100,19 @@ u256 EVMInstructionInterpreter::eval(
 	case Instruction::ADD:
 		return arg[0] + arg[1];
 	case Instruction::MUL:
-		return arg[0] * arg[1];
+		return u256(Word256(arg[0]) * Word256(arg[1]));
 	case Instruction::SUB:
 		return arg[0] - arg[1];
 	case Instruction::DIV:
-		return arg[1] == 0 ? 0 : arg[0] / arg[1];
+		return u256(Word256(arg[0]) / Word256(arg[1]));
 	case Instruction::SDIV:
-		return arg[1] == 0 ? 0 : s2u(u2s(arg[0]) / u2s(arg[1]));
+		return u256(util::signedDiv(Word256(arg[0]), Word256(arg[1])));
 	case Instruction::MOD:
-		return arg[1] == 0 ? 0 : arg[0] % arg[1];
+		return u256(Word256(arg[0]) % Word256(arg[1]));
 	case Instruction::SMOD:
-		return arg[1] == 0 ? 0 : s2u(u2s(arg[0]) % u2s(arg[1]));
+		return u256(util::signedMod(Word256(arg[0]), Word256(arg[1])));
 	case Instruction::EXP:
-		return exp256(arg[0], arg[1]);
+		return u256(util::power(Word256(arg[0]), Word256(arg[1])));
 	case Instruction::NOT:
 		return ~arg[0];
 	case Instruction::LT:
@@ -120,9 +120,9 @@ u256 EVMInstructionInterpreter::eval(
 	case Instruction::GT:
 		return arg[0] > arg[1] ? 1 : 0;
 	case Instruction::SLT:
-		return u2s(arg[0]) < u2s(arg[1]) ? 1 : 0;
+		return util::signedLessThan(Word256(arg[0]), Word256(arg[1])) ? 1 : 0;
 	case Instruction::SGT:
-		return u2s(arg[0]) > u2s(arg[1]) ? 1 : 0;
+		return util::signedLessThan(Word256(arg[1]), Word256(arg[0])) ? 1 : 0;
 	case Instruction::EQ:
 		return arg[0] == arg[1] ? 1 : 0;
 	case Instruction::ISZERO:
@@ -140,37 +140,13 @@ u256 EVMInstructionInterpreter::eval(
 	case Instruction::SHR:
 		return arg[0] > 255 ? 0 : (arg[1] >> unsigned(arg[0]));
 	case Instruction::SAR:
-	{
-		static u256 const hibit = u256(1) << 255;
-		if (arg[0] >= 256)
-			return arg[1] & hibit ? u256(-1) : 0;
-		else
-		{
-			unsigned amount = unsigned(arg[0]);
-			u256 v = arg[1] >> amount;
-			if (arg[1] & hibit)
-				v |= u256(-1) << (256 - amount);
-			return v;
-		}
-	}
+		return u256(util::arithmeticShiftRight(Word256(arg[1]), Word256(arg[0])));
 	case Instruction::ADDMOD:
-		return arg[2] == 0 ? 0 : u256((u512(arg[0]) + u512(arg[1])) % arg[2]);
+		return u256(util::addMod(Word256(arg[0]), Word256(arg[1]), Word256(arg[2])));
 	case Instruction::MULMOD:
-		return arg[2] == 0 ? 0 : u256((u512(arg[0]) * u512(arg[1])) % arg[2]);
+		return u256(util::mulMod(Word256(arg[0]), Word256(arg[1]), Word256(arg[2])));
 	case Instruction::SIGNEXTEND:
-		if (arg[0] >= 31)
-			return arg[1];
-		else
-		{
-			unsigned testBit = unsigned(arg[0]) * 8 + 7;
-			u256 ret = arg[1];
-			u256 mask = ((u256(1) << testBit) - 1);
-			if (boost::multiprecision::bit_test(ret, testBit))
-				ret |= ~mask;
-			else
-				ret &= mask;
-			return ret;
-		}
+		return u256(util::signExtend(Word256(arg[0]), Word256(arg[1])));
 	// --------------- blockchain stuff ---------------
 	case Instruction::KECCAK256:
 	{